@@ -0,0 +1,588 @@
+/*
+ * benchmark.cpp
+ *
+ *
+ * @date 16-10-2026
+ * @version 1.00
+ * Banc d'essai des solveurs (sudoku, futoshiki, recuit simulé) et des fils d'exécution
+ */
+
+// cmake --build build --target benchmark
+// Exécution directe : benchmarkBin [corpus] [results.json]
+// Le corpus est le répertoire benchmark/corpus (une grille par ligne, les lignes '#' sont des commentaires).
+// Les résultats sont écrits en JSON (un objet par mesure) pour suivre les régressions d'une version à l'autre.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "sudoku_model.h"
+#include "futoshiki_model.h"
+#include "puzzleCorpus.h"
+#include "recuitSimule.h"
+#include "EventThread.h"
+
+#ifndef BENCHMARK_CORPUS_DIR
+#define BENCHMARK_CORPUS_DIR "benchmark/corpus"
+#endif
+
+using clock_type = std::chrono::steady_clock;
+
+// Résultat d'une mesure : micro (une opération répétée) ou macro (un corpus)
+struct result_t
+{
+  std::string Name;
+  std::string Kind;
+  size_t Items = 0U;
+  std::chrono::nanoseconds Elapsed = std::chrono::nanoseconds::zero();
+  std::chrono::nanoseconds P50 = std::chrono::nanoseconds::zero();
+  std::chrono::nanoseconds P99 = std::chrono::nanoseconds::zero();
+  size_t Nodes = 0U;
+  size_t Failures = 0U;
+  // Méthode exacte : un échec est une régression (le recuit simulé peut ne pas converger)
+  bool Exact = true;
+
+  double itemsPerSecond() const
+  {
+    const double seconds = std::chrono::duration<double>(Elapsed).count();
+    return (seconds > 0.0) ? (static_cast<double>(Items) / seconds) : 0.0;
+  }
+
+  void writeJson(std::ostream& os) const
+  {
+    os << "{\"name\":\"" << Name << "\""
+       << ",\"kind\":\"" << Kind << "\""
+       << ",\"items\":" << Items
+       << ",\"elapsedNs\":" << Elapsed.count()
+       << ",\"itemsPerSecond\":" << static_cast<size_t>(itemsPerSecond())
+       << ",\"p50Ns\":" << P50.count()
+       << ",\"p99Ns\":" << P99.count()
+       << ",\"nodes\":" << Nodes
+       << ",\"failures\":" << Failures
+       << ",\"exact\":" << (Exact ? "true" : "false") << "}";
+  }
+};
+
+// Mesure chaque élément : fct(item) retourne {réussite, noeuds}
+template<class T, class FctT>
+result_t measure(const std::string& name, const std::string& kind, const std::vector<T>& items, FctT&& fct)
+{
+  result_t result{name, kind};
+  std::vector<std::chrono::nanoseconds> latencies;
+  latencies.reserve(items.size());
+  for (const T& item : items)
+  {
+    const clock_type::time_point start = clock_type::now();
+    const auto [success, nodes] = fct(item);
+    latencies.push_back(clock_type::now() - start);
+    result.Nodes += nodes;
+    result.Failures += success ? 0U : 1U;
+  }
+  result.Items = items.size();
+  for (const std::chrono::nanoseconds latency : latencies)
+  {
+    result.Elapsed += latency;
+  }
+  if (!latencies.empty())
+  {
+    std::sort(latencies.begin(), latencies.end());
+    result.P50 = latencies[(latencies.size() - 1U) / 2U];
+    result.P99 = latencies[((latencies.size() * 99U) + 99U) / 100U - 1U];
+  }
+  return result;
+}
+
+// Conserve une mesure et l'affiche
+void record(std::vector<result_t>& results, const result_t& result)
+{
+  std::cout << result.Name << ": items=" << result.Items
+            << " items/s=" << static_cast<size_t>(result.itemsPerSecond())
+            << " p50=" << std::chrono::duration_cast<std::chrono::microseconds>(result.P50).count() << "us"
+            << " p99=" << std::chrono::duration_cast<std::chrono::microseconds>(result.P99).count() << "us"
+            << " nodes=" << result.Nodes << " failures=" << result.Failures << std::endl;
+  results.push_back(result);
+}
+
+// Les modes de retour arrière (copie et journal) parcourent le même arbre : un écart du nombre de noeuds est un échec
+void sameTree(result_t& result, const result_t& reference)
+{
+  if (result.Nodes != reference.Nodes)
+  {
+    std::cerr << result.Name << ": nodes=" << result.Nodes << " but " << reference.Name << ": nodes=" << reference.Nodes << std::endl;
+    ++result.Failures;
+  }
+}
+
+// Lignes d'un fichier du corpus, sans les commentaires
+std::vector<std::string> readCorpus(const std::string& path)
+{
+  std::vector<std::string> lines;
+  std::ifstream input(path);
+  std::string line;
+  while (std::getline(input, line))
+  {
+    if (!line.empty() && (line.back() == '\r'))
+    {
+      line.pop_back();
+    }
+    if (!line.empty() && (line.front() != '#'))
+    {
+      lines.push_back(line);
+    }
+  }
+  if (lines.empty())
+  {
+    std::cerr << "empty corpus " << path << std::endl;
+  }
+  return lines;
+}
+
+// Magasin des variables du solveur générique : domaines en std::set ou en bitset, variables indexées,
+// règles du carré latin en contraintes statiques
+enum class store_t
+{
+  Set,
+  Bitset,
+  Dense,
+  Static
+};
+
+// Configuration du solveur générique comparée sur la grille d'un programme. Une configuration par journal nomme
+// la configuration par copie dont elle doit parcourir le même arbre (SameTreeAs).
+template<class OptionsT>
+struct configuration_t
+{
+  std::string Name;
+  store_t Store;
+  OptionsT Options;
+  std::string SameTreeAs = {};
+};
+
+// Répétitions de la grille d'un programme pour chaque configuration
+constexpr size_t ConfigurationRepetitions = 20U;
+
+// Appelle fct(std::type_identity<SolverT>{}) avec le solveur du magasin
+template<class SetT, class BitsetT, class DenseT, class StaticT, class FctT>
+result_t withStore(const store_t store, FctT&& fct)
+{
+  switch (store)
+  {
+  case store_t::Set:
+    return fct(std::type_identity<SetT>{});
+  case store_t::Bitset:
+    return fct(std::type_identity<BitsetT>{});
+  case store_t::Dense:
+    return fct(std::type_identity<DenseT>{});
+  default:
+    return fct(std::type_identity<StaticT>{});
+  }
+}
+
+// Conserve la mesure d'une configuration, comparée à la configuration par copie déjà mesurée dont elle suit l'arbre
+template<class OptionsT>
+void record(std::vector<result_t>& results, result_t result, const std::string& prefix, const configuration_t<OptionsT>& configuration)
+{
+  if (!configuration.SameTreeAs.empty())
+  {
+    const std::string reference = prefix + configuration.SameTreeAs;
+    const auto found = std::find_if(results.begin(), results.end(), [&reference](const result_t& r) { return r.Name == reference; });
+    if (found != results.end())
+    {
+      sameTree(result, *found);
+    }
+    else
+    {
+      std::cerr << result.Name << ": no configuration " << reference << std::endl;
+      ++result.Failures;
+    }
+  }
+  record(results, result);
+}
+
+// Configurations comparées sur la grille du programme sudoku
+std::vector<configuration_t<sudoku::options_t>> sudokuConfigurations()
+{
+  constexpr solver::BacktrackMode Trail = solver::BacktrackMode::Trail;
+  const size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+  return {
+    {"std::set", store_t::Set, {}},
+    {"std::set+trail", store_t::Set, {.Mode = Trail}, "std::set"},
+    {"bitset", store_t::Bitset, {}},
+    {"bitset+trail", store_t::Bitset, {.Mode = Trail}, "bitset"},
+    {"bitset+dense", store_t::Dense, {}},
+    {"bitset+trail+dense", store_t::Dense, {.Mode = Trail}, "bitset+dense"},
+    {"bitset+trail+dense+parallel", store_t::Dense, {.Mode = Trail, .Threads = threads}},
+    {"bitset+trail+dense+alldiff(bounds)", store_t::Dense, {.Mode = Trail, .AllDifferent = solver::Consistency::Bounds}},
+    {"bitset+trail+dense+alldiff(domain)", store_t::Dense, {.Mode = Trail, .AllDifferent = solver::Consistency::Domain}},
+    {"bitset+trail+dense+dom", store_t::Dense, {.Mode = Trail, .Order = solver::Heuristic::Dom}},
+    {"bitset+trail+dense+dom/wdeg", store_t::Dense, {.Mode = Trail, .Order = solver::Heuristic::DomWdeg}},
+    {"bitset+trail+dense+impact", store_t::Dense, {.Mode = Trail, .Order = solver::Heuristic::Impact}},
+    {"bitset+trail+dense+dom/wdeg+backjumping", store_t::Dense, {.Mode = Trail, .Order = solver::Heuristic::DomWdeg, .Backjumping = true}},
+    {"bitset+trail+dense+decomposition", store_t::Dense, {.Mode = Trail, .Decomposition = true}},
+    {"bitset+trail+dense+decomposition+parallel", store_t::Dense, {.Mode = Trail, .Threads = threads, .Decomposition = true}},
+    {"bitset+trail+dense+dom/wdeg+luby+random", store_t::Dense,
+     {.Mode = Trail, .Order = solver::Heuristic::DomWdeg, .Restarts = solver::Restart::Luby, .Randomize = true}},
+    {"bitset+trail+dense+static", store_t::Static, {.Mode = Trail}},
+  };
+}
+
+// Configurations comparées sur la grille du programme futoshiki, dont la propagation globale des inégalités
+std::vector<configuration_t<futoshiki::options_t>> futoshikiConfigurations()
+{
+  constexpr solver::BacktrackMode Trail = solver::BacktrackMode::Trail;
+  const size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+  return {
+    {"std::set+global", store_t::Set, {.EventDriven = false}},
+    {"std::set", store_t::Set, {}},
+    {"std::set+trail", store_t::Set, {.Mode = Trail}, "std::set"},
+    {"bitset", store_t::Bitset, {}},
+    {"bitset+trail", store_t::Bitset, {.Mode = Trail}, "bitset"},
+    {"bitset+trail+dense+global", store_t::Dense, {.Mode = Trail, .EventDriven = false}},
+    {"bitset+dense", store_t::Dense, {}},
+    {"bitset+trail+dense", store_t::Dense, {.Mode = Trail}, "bitset+dense"},
+    {"bitset+trail+dense+parallel", store_t::Dense, {.Mode = Trail, .Threads = threads}},
+    {"bitset+trail+dense+alldiff(bounds)", store_t::Dense, {.Mode = Trail, .AllDifferent = solver::Consistency::Bounds}},
+    {"bitset+trail+dense+alldiff(domain)", store_t::Dense, {.Mode = Trail, .AllDifferent = solver::Consistency::Domain}},
+    {"bitset+trail+dense+dom", store_t::Dense, {.Mode = Trail, .Order = solver::Heuristic::Dom}},
+    {"bitset+trail+dense+dom/wdeg", store_t::Dense, {.Mode = Trail, .Order = solver::Heuristic::DomWdeg}},
+    {"bitset+trail+dense+impact", store_t::Dense, {.Mode = Trail, .Order = solver::Heuristic::Impact}},
+    {"bitset+trail+dense+dom/wdeg+backjumping", store_t::Dense, {.Mode = Trail, .Order = solver::Heuristic::DomWdeg, .Backjumping = true}},
+    {"bitset+trail+dense+decomposition", store_t::Dense, {.Mode = Trail, .Decomposition = true}},
+    {"bitset+trail+dense+decomposition+parallel", store_t::Dense, {.Mode = Trail, .Threads = threads, .Decomposition = true}},
+    {"bitset+trail+dense+dom/wdeg+luby+random", store_t::Dense,
+     {.Mode = Trail, .Order = solver::Heuristic::DomWdeg, .Restarts = solver::Restart::Luby, .Randomize = true}},
+    {"bitset+trail+dense+static", store_t::Static, {.Mode = Trail}},
+  };
+}
+
+// Sudoku : chaque configuration du solveur générique sur la grille du programme, solution vérifiée
+void benchmarkSudokuConfigurations(const sudoku::grid_t& values, std::vector<result_t>& results)
+{
+  using namespace sudoku;
+  const std::vector<grid_t> repeated(ConfigurationRepetitions, values);
+  for (const configuration_t<options_t>& configuration : sudokuConfigurations())
+  {
+    record(results, withStore<solver_constraint_t, solver_bitset_t, solver_dense_t, solver_static_t>(configuration.Store,
+      [&configuration, &repeated](const auto store)
+    {
+      typename decltype(store)::type algoC;
+      return measure("sudoku/config/" + configuration.Name, "micro", repeated, [&configuration, &algoC](const grid_t& grid)
+      {
+        algoC = {};
+        configure(algoC, configuration.Options);
+        setup(algoC, grid, configuration.Options);
+        const bool solved = algoC.solve();
+        const std::string solution = format([&algoC](const tda::Coord& c) { return algoC.get(c).value(); });
+        return std::make_pair(solved && valid(grid, solution), algoC.choicePoints());
+      });
+    }), "sudoku/config/", configuration);
+  }
+}
+
+// Futoshiki : chaque configuration du solveur générique sur la grille du programme, solution vérifiée
+void benchmarkFutoshikiConfigurations(std::vector<result_t>& results)
+{
+  using namespace futoshiki;
+  constexpr size_t N = 9U;
+  const std::optional<puzzle_t<N>> puzzle = parse<N>({
+    "0 0<0 0 0 4 5 7 3",
+    "                 ",
+    "1 0 0 0>0 6<0<0 7",
+    "      ^         v",
+    "0>0 0<4>0 7<0 0<0",
+    "                 ",
+    "0 0 0<0 0 0 0 0 0",
+    "^         v      ",
+    "0<0 5>0 0 0 0 0 0",
+    "v       v        ",
+    "0 0 0 0 0<0 0 0 0",
+    "        v        ",
+    "0 0 0 0 0 3<0 0 0",
+    "      v v        ",
+    "0 0 0<7 0 9 0<5 2",
+    "        v     v  ",
+    "0 0 0 0 0<0 1 0 0"
+  });
+  if (!puzzle.has_value())
+  {
+    std::cerr << "invalid futoshiki grid" << std::endl;
+    return;
+  }
+  const std::vector<puzzle_t<N>> repeated(ConfigurationRepetitions, *puzzle);
+  for (const configuration_t<options_t>& configuration : futoshikiConfigurations())
+  {
+    record(results, withStore<set_solver_t, bitset_solver_t<N>, dense_solver_t<N>, static_solver_t<N>>(configuration.Store,
+      [&configuration, &repeated](const auto store)
+    {
+      typename decltype(store)::type algoC;
+      return measure("futoshiki/config/" + configuration.Name, "micro", repeated, [&configuration, &algoC](const puzzle_t<N>& grid)
+      {
+        algoC = {};
+        configure(algoC, configuration.Options);
+        const bool solved = setup(algoC, grid.model(), configuration.Options) && algoC.solve();
+        const std::string solution = format<N>([&algoC](const tda::Coord& c) { return algoC.get(c).value(); });
+        return std::make_pair(solved && valid(grid, solution), algoC.choicePoints());
+      });
+    }), "futoshiki/config/", configuration);
+  }
+}
+
+// Sudoku : une grille répétée (micro) puis chaque corpus (macro), moteurs spécialisés (LatinSquare, bandes)
+// et solveur générique ; le moteur par bandes parcourt le même arbre que LatinSquare
+void benchmarkSudoku(const std::string& corpus, std::vector<result_t>& results)
+{
+  using sudoku::grid_t;
+  sudoku::solver_latin_t algoL;
+  sudoku::solver_bands_t algoB;
+  sudoku::solver_static_t algoC;
+  algoC.setBacktrackMode(solver::BacktrackMode::Trail);
+  sudoku::model(algoC);
+  sudoku::solver_static_t algoCopy;
+  sudoku::model(algoCopy);
+  const auto bitboard = [&algoL](const grid_t& values)
+  {
+    const bool solved = sudoku::setup(algoL, values) && algoL.solve();
+    const std::string solution = sudoku::format([&algoL](const tda::Coord& c) { return algoL.value(c); });
+    return std::make_pair(solved && sudoku::valid(values, solution), algoL.choicePoints());
+  };
+  const auto bands = [&algoB](const grid_t& values)
+  {
+    const bool solved = sudoku::setup(algoB, values) && algoB.solve();
+    const std::string solution = sudoku::format([&algoB](const tda::Coord& c) { return algoB.value(c); });
+    return std::make_pair(solved && sudoku::valid(values, solution), algoB.choicePoints());
+  };
+  const auto generic = [](sudoku::solver_static_t& algoC)
+  {
+    return [&algoC](const grid_t& values)
+    {
+      algoC.reset();
+      algoC.resetStatistics();
+      sudoku::load(algoC, values);
+      const bool solved = algoC.solve();
+      const std::string solution = sudoku::format([&algoC](const tda::Coord& c) { return algoC.get(c).value(); });
+      return std::make_pair(solved && sudoku::valid(values, solution), algoC.choicePoints());
+    };
+  };
+
+  // Grille du programme sudoku
+  const std::optional<grid_t> single = sudoku::parse("800000040300800560002003000500000004007060950000900002200600830000000009010070000");
+  const std::vector<grid_t> repeated(1000U, *single);
+  const result_t singleLatin = measure("sudoku/single/bitboard", "micro", repeated, bitboard);
+  result_t singleBands = measure("sudoku/single/bands", "micro", repeated, bands);
+  sameTree(singleBands, singleLatin);
+  record(results, singleLatin);
+  record(results, singleBands);
+  record(results, measure("sudoku/single/generic", "micro", repeated, generic(algoC)));
+  benchmarkSudokuConfigurations(*single, results);
+
+  for (const char* level : {"easy", "medium", "hard", "17"})
+  {
+    std::vector<grid_t> grids;
+    for (const std::string& line : readCorpus(corpus + "/sudoku_" + level + ".txt"))
+    {
+      if (const std::optional<grid_t> values = sudoku::parse(line); values.has_value())
+      {
+        grids.push_back(*values);
+      }
+    }
+    const result_t latin = measure(std::string("sudoku/") + level + "/bitboard", "macro", grids, bitboard);
+    result_t band = measure(std::string("sudoku/") + level + "/bands", "macro", grids, bands);
+    sameTree(band, latin);
+    record(results, latin);
+    record(results, band);
+    const result_t trail = measure(std::string("sudoku/") + level + "/generic", "macro", grids, generic(algoC));
+    result_t copy = measure(std::string("sudoku/") + level + "/generic+copy", "macro", grids, generic(algoCopy));
+    sameTree(copy, trail);
+    record(results, trail);
+    record(results, copy);
+  }
+}
+
+// Chargement d'un corpus : analyse des lignes de texte ou vues sur le corpus binaire projeté en mémoire,
+// jusqu'à la grille du moteur spécialisé (sans résolution)
+void benchmarkCorpus(const std::string& corpus, const std::string& binary, std::vector<result_t>& results)
+{
+  std::vector<std::string> lines;
+  for (const char* level : {"easy", "medium", "hard", "17"})
+  {
+    const std::vector<std::string> grids = readCorpus(corpus + "/sudoku_" + level + ".txt");
+    lines.insert(lines.end(), grids.begin(), grids.end());
+  }
+  {
+    solver::CorpusWriter writer;
+    writer.open(binary, solver::CorpusKind::Sudoku, sudoku::SquareSize);
+    for (const std::string& line : lines)
+    {
+      writer.write(sudoku::encode(*sudoku::parse(line)));
+    }
+    writer.close();
+  }
+  solver::MappedCorpus grids;
+  std::vector<size_t> indices(grids.open(binary) ? grids.count() : 0U);
+  std::iota(indices.begin(), indices.end(), 0U);
+
+  sudoku::solver_bands_t algoL;
+  record(results, measure("corpus/sudoku/text", "micro", lines, [&algoL](const std::string& line)
+  {
+    const std::optional<sudoku::grid_t> values = sudoku::parse(line);
+    return std::make_pair(values.has_value() && sudoku::setup(algoL, *values), size_t{0U});
+  }));
+  record(results, measure("corpus/sudoku/mapped", "micro", indices, [&algoL, &grids](const size_t index)
+  {
+    return std::make_pair(sudoku::setup(algoL, grids[index]), size_t{0U});
+  }));
+}
+
+// Futoshiki N x N : les inégalités dépendent de la grille, le solveur générique est construit pour chaque grille
+template<size_t N>
+void benchmarkFutoshiki(const std::string& corpus, std::vector<result_t>& results)
+{
+  constexpr size_t GridSize = (2U * N) - 1U;
+  std::vector<futoshiki::puzzle_t<N>> puzzles;
+  for (const std::string& line : readCorpus(corpus + "/futoshiki_" + std::to_string(N) + ".txt"))
+  {
+    std::vector<std::string> rows;
+    for (size_t i = 0U; (i < GridSize) && (line.size() == GridSize * GridSize); ++i)
+    {
+      rows.push_back(line.substr(i * GridSize, GridSize));
+    }
+    if (std::optional<futoshiki::puzzle_t<N>> puzzle = futoshiki::parse<N>(rows); puzzle.has_value())
+    {
+      puzzles.push_back(std::move(*puzzle));
+    }
+  }
+  const std::string name = "futoshiki/" + std::to_string(N) + "x" + std::to_string(N);
+  solver::LatinSquare<N> algoL;
+  record(results, measure(name + "/bitboard", "macro", puzzles, [&algoL](const futoshiki::puzzle_t<N>& puzzle)
+  {
+    const bool solved = futoshiki::setup(algoL, puzzle.model()) && algoL.solve();
+    const std::string solution = futoshiki::format<N>([&algoL](const tda::Coord& c) { return algoL.value(c); });
+    return std::make_pair(solved && futoshiki::valid(puzzle, solution), algoL.choicePoints());
+  }));
+  const auto generic = [](const solver::BacktrackMode mode)
+  {
+    return [mode](const futoshiki::puzzle_t<N>& puzzle)
+    {
+      futoshiki::static_solver_t<N> algoC;
+      algoC.setBacktrackMode(mode);
+      const bool solved = futoshiki::setup(algoC, puzzle.model(), {}) && algoC.solve();
+      const std::string solution = futoshiki::format<N>([&algoC](const tda::Coord& c) { return algoC.get(c).value(); });
+      return std::make_pair(solved && futoshiki::valid(puzzle, solution), algoC.choicePoints());
+    };
+  };
+  const result_t trail = measure(name + "/generic", "macro", puzzles, generic(solver::BacktrackMode::Trail));
+  result_t copy = measure(name + "/generic+copy", "macro", puzzles, generic(solver::BacktrackMode::Copy));
+  sameTree(copy, trail);
+  record(results, trail);
+  record(results, copy);
+}
+
+// Recuit simulé du programme futoshiki_recuitsimule, avec des graines fixes
+void benchmarkAnnealing(std::vector<result_t>& results)
+{
+  constexpr size_t SizeOfSquare = 4U;
+  const tda::Futoshiki<SizeOfSquare> f {
+    {
+      tda::InferiorConstraint{tda::Coord::From2D1Based(1U, 3U), tda::Direction::Left},
+      tda::InferiorConstraint{tda::Coord::From2D1Based(2U, 1U), tda::Direction::Right},
+      tda::InferiorConstraint{tda::Coord::From2D1Based(3U, 4U), tda::Direction::Down},
+    },
+    {
+      tda::Assertion{tda::Coord::From2D1Based(4U, 1U), 1U},
+      tda::Assertion{tda::Coord::From2D1Based(2U, 3U), 3U},
+    }
+  };
+  const std::vector<unsigned> seeds = {1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U};
+  result_t result = measure("annealing/futoshiki4x4", "macro", seeds, [&f](const unsigned seed)
+  {
+    solver::RecuitSimule<tda::Futoshiki<SizeOfSquare>, size_t, tda::Coord> algoRS(f, seed);
+    return std::make_pair(algoRS.start().getViolationsCount() == 0U, size_t{0U});
+  });
+  result.Exact = false;
+  record(results, result);
+}
+
+// Débit de event_thread : notifications traitées par seconde
+void benchmarkEventThread(std::vector<result_t>& results)
+{
+  constexpr size_t Events = 100000U;
+  std::atomic<size_t> received = 0U;
+  size_t checksum = 0U;
+  std::mutex mutex;
+  std::condition_variable done;
+  ExNs::event_thread thread;
+  thread = ExNs::event_thread([&]()
+  {
+    std::tuple<size_t> msg;
+    if (thread.getEvent(msg))
+    {
+      checksum += std::get<0>(msg);
+    }
+    if (received.fetch_add(1U) + 1U == Events)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      done.notify_one();
+    }
+    return false;
+  });
+  thread.start();
+
+  result_t result{"thread/event_thread", "macro"};
+  const clock_type::time_point start = clock_type::now();
+  for (size_t e = 0U; e < Events; ++e)
+  {
+    thread.notifyEvent(e);
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&received]() { return received.load() == Events; });
+  }
+  result.Elapsed = clock_type::now() - start;
+  result.Items = Events;
+  result.Failures = (checksum == (Events * (Events - 1U)) / 2U) ? 0U : 1U;
+  record(results, result);
+}
+
+int main(int argc, char* argv[])
+{
+  const std::string corpus = (argc > 1) ? argv[1] : BENCHMARK_CORPUS_DIR;
+  std::vector<result_t> results;
+  benchmarkSudoku(corpus, results);
+  benchmarkCorpus(corpus, (argc > 2) ? std::string(argv[2]) + ".corpus" : std::string("benchmark.corpus"), results);
+  benchmarkFutoshiki<5U>(corpus, results);
+  benchmarkFutoshiki<6U>(corpus, results);
+  benchmarkFutoshiki<7U>(corpus, results);
+  benchmarkFutoshiki<8U>(corpus, results);
+  benchmarkFutoshiki<9U>(corpus, results);
+  benchmarkFutoshikiConfigurations(results);
+  benchmarkAnnealing(results);
+  benchmarkEventThread(results);
+
+  bool success = true;
+  for (const result_t& result : results)
+  {
+    success = success && (result.Items > 0U) && (!result.Exact || (result.Failures == 0U));
+  }
+  if (argc > 2)
+  {
+    std::ofstream output(argv[2]);
+    output << "{\"benchmarks\":[\n";
+    for (size_t r = 0U; r < results.size(); ++r)
+    {
+      results[r].writeJson(output);
+      output << ((r + 1U < results.size()) ? ",\n" : "\n");
+    }
+    output << "]}" << std::endl;
+  }
+  return success ? 0 : 1;
+}
@@ -0,0 +1,284 @@
+#ifndef BATCH_PIPELINE_H
+#define BATCH_PIPELINE_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "puzzleCorpus.h"
+
+namespace solver
+{
+
+  // File bloquante entre deux étages du traitement par lots
+  template <class T>
+  class BlockingQueue
+  {
+  public:
+    void
+    push(T item)
+    {
+      {
+        std::lock_guard<std::mutex> lock(Mutex);
+        Items.push_back(std::move(item));
+      }
+      Ready.notify_one();
+    }
+
+    // Attend un élément, std::nullopt une fois la file fermée et vidée
+    std::optional<T>
+    pop()
+    {
+      std::unique_lock<std::mutex> lock(Mutex);
+      Ready.wait(lock, [this]()
+                 { return !Items.empty() || Closed; });
+      std::optional<T> item;
+      if (!Items.empty())
+      {
+        item = std::move(Items.front());
+        Items.pop_front();
+      }
+      return item;
+    }
+
+    void
+    close()
+    {
+      {
+        std::lock_guard<std::mutex> lock(Mutex);
+        Closed = true;
+      }
+      Ready.notify_all();
+    }
+
+  private:
+    std::mutex Mutex;
+    std::condition_variable Ready;
+    std::deque<T> Items;
+    bool Closed = false;
+  };
+
+  // Bilan d'un traitement par lots : débit et percentiles de la latence de résolution
+  struct BatchReport
+  {
+    size_t Puzzles = 0U;
+    std::chrono::nanoseconds Elapsed = std::chrono::nanoseconds::zero();
+    std::chrono::nanoseconds P50 = std::chrono::nanoseconds::zero();
+    std::chrono::nanoseconds P90 = std::chrono::nanoseconds::zero();
+    std::chrono::nanoseconds P99 = std::chrono::nanoseconds::zero();
+    std::chrono::nanoseconds Max = std::chrono::nanoseconds::zero();
+
+    // Problèmes résolus par seconde
+    double
+    throughput() const
+    {
+      const double seconds = std::chrono::duration<double>(Elapsed).count();
+      return (seconds > 0.0) ? (static_cast<double>(Puzzles) / seconds) : 0.0;
+    }
+
+    void
+    write(std::ostream &os) const
+    {
+      using us = std::chrono::microseconds;
+      os << "puzzles=" << Puzzles
+         << " elapsed=" << std::chrono::duration_cast<std::chrono::milliseconds>(Elapsed).count() << "ms"
+         << " puzzles/s=" << static_cast<size_t>(throughput())
+         << " p50=" << std::chrono::duration_cast<us>(P50).count() << "us"
+         << " p90=" << std::chrono::duration_cast<us>(P90).count() << "us"
+         << " p99=" << std::chrono::duration_cast<us>(P99).count() << "us"
+         << " max=" << std::chrono::duration_cast<us>(Max).count() << "us";
+    }
+  };
+
+  // Traitement par lots en trois étages reliés par des files :
+  // - un fil lit les problèmes : next() retourne le suivant, std::nullopt à la fin de l'entrée
+  // - threads fils résolvent les problèmes, chacun avec son propre contexte créé par makeContext()
+  //   (un solveur réutilisé d'un problème à l'autre par exemple) : solve(context, problem) retourne le résultat
+  // - le fil appelant passe les résultats à write(result) dans l'ordre de l'entrée
+  // Au plus window problèmes sont lus et non encore écrits : un problème difficile retarde l'écriture
+  // sans faire croître la mémoire, les autres fils continuent de résoudre les problèmes suivants.
+  template <class NextT, class WriteT, class MakeT, class SolveT>
+  BatchReport
+  runPipeline(NextT &&next, WriteT &&write, const size_t threads, MakeT &&makeContext, SolveT &&solve,
+              const size_t window = 4096U)
+  {
+    using problem_t = typename std::invoke_result_t<NextT &>::value_type;
+    using context_t = std::invoke_result_t<MakeT &>;
+    using output_t = std::invoke_result_t<SolveT &, context_t &, const problem_t &>;
+    struct job_t
+    {
+      size_t Index;
+      problem_t Problem;
+    };
+    struct result_t
+    {
+      size_t Index;
+      output_t Output;
+      std::chrono::nanoseconds Latency;
+    };
+    BlockingQueue<job_t> jobs;
+    BlockingQueue<result_t> results;
+    // Fenêtre des problèmes en cours : le lecteur attend que l'écrivain libère des places
+    std::mutex windowMutex;
+    std::condition_variable windowFree;
+    size_t inFlight = 0U;
+    const size_t capacity = std::max<size_t>(window, 1U);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::thread reader([&]()
+    {
+      size_t index = 0U;
+      while (std::optional<problem_t> problem = next())
+      {
+        {
+          std::unique_lock<std::mutex> lock(windowMutex);
+          windowFree.wait(lock, [&]()
+                          { return inFlight < capacity; });
+          ++inFlight;
+        }
+        jobs.push(job_t{index, std::move(*problem)});
+        ++index;
+      }
+      jobs.close();
+    });
+
+    std::vector<std::thread> workers;
+    const size_t count = std::max<size_t>(threads, 1U);
+    workers.reserve(count);
+    for (size_t w = 0U; w < count; ++w)
+    {
+      workers.emplace_back([&]()
+      {
+        context_t context = makeContext();
+        while (std::optional<job_t> job = jobs.pop())
+        {
+          const auto begin = std::chrono::steady_clock::now();
+          output_t output = solve(context, job->Problem);
+          const auto latency = std::chrono::steady_clock::now() - begin;
+          results.push(result_t{job->Index, std::move(output), std::chrono::duration_cast<std::chrono::nanoseconds>(latency)});
+        }
+      });
+    }
+    std::thread closer([&]()
+    {
+      for (std::thread &worker : workers)
+      {
+        worker.join();
+      }
+      results.close();
+    });
+
+    // Ecriture dans l'ordre de l'entrée : les résultats arrivés en avance attendent leur tour
+    BatchReport report;
+    std::vector<std::chrono::nanoseconds> latencies;
+    std::map<size_t, output_t> pending;
+    size_t nextIndex = 0U;
+    while (std::optional<result_t> result = results.pop())
+    {
+      latencies.push_back(result->Latency);
+      pending.emplace(result->Index, std::move(result->Output));
+      size_t written = 0U;
+      for (auto it = pending.begin(); (it != pending.end()) && (it->first == nextIndex); it = pending.erase(it))
+      {
+        write(std::move(it->second));
+        ++nextIndex;
+        ++written;
+      }
+      if (written > 0U)
+      {
+        {
+          std::lock_guard<std::mutex> lock(windowMutex);
+          inFlight -= written;
+        }
+        windowFree.notify_one();
+      }
+    }
+    reader.join();
+    closer.join();
+
+    report.Elapsed = std::chrono::steady_clock::now() - start;
+    report.Puzzles = latencies.size();
+    if (!latencies.empty())
+    {
+      std::sort(latencies.begin(), latencies.end());
+      const auto percentile = [&latencies](const size_t p)
+      {
+        const size_t rank = (p * latencies.size() + 99U) / 100U;
+        return latencies[std::max<size_t>(rank, 1U) - 1U];
+      };
+      report.P50 = percentile(50U);
+      report.P90 = percentile(90U);
+      report.P99 = percentile(99U);
+      report.Max = latencies.back();
+    }
+    return report;
+  }
+
+  // Traitement par lots d'un corpus texte (un problème par ligne, les lignes vides et les commentaires '#'
+  // sont ignorés) : solve(context, line) retourne la ligne à écrire
+  template <class MakeT, class SolveT>
+  BatchReport
+  runBatch(std::istream &input, std::ostream &output, const size_t threads, MakeT &&makeContext, SolveT &&solve,
+           const size_t window = 4096U)
+  {
+    BatchReport report = runPipeline(
+      [&input]()
+      {
+        std::optional<std::string> problem;
+        std::string line;
+        while (!problem.has_value() && std::getline(input, line))
+        {
+          if (!line.empty() && (line.back() == '\r'))
+          {
+            line.pop_back();
+          }
+          if (!line.empty() && (line.front() != '#'))
+          {
+            problem = std::move(line);
+          }
+        }
+        return problem;
+      },
+      [&output](std::string &&line)
+      {
+        output << line << '\n';
+      },
+      threads, std::forward<MakeT>(makeContext), std::forward<SolveT>(solve), window);
+    output.flush();
+    return report;
+  }
+
+  // Traitement par lots d'un corpus binaire projeté en mémoire : solve(context, view) reçoit une vue
+  // sur l'enregistrement, sans copie ni analyse de texte, write(result) reçoit les résultats dans l'ordre
+  template <class WriteT, class MakeT, class SolveT>
+  BatchReport
+  runBatch(const MappedCorpus &corpus, WriteT &&write, const size_t threads, MakeT &&makeContext, SolveT &&solve,
+           const size_t window = 4096U)
+  {
+    size_t index = 0U;
+    return runPipeline(
+      [&corpus, &index]()
+      {
+        std::optional<GridView> problem;
+        if (index < corpus.count())
+        {
+          problem = corpus[index];
+          ++index;
+        }
+        return problem;
+      },
+      std::forward<WriteT>(write), threads, std::forward<MakeT>(makeContext), std::forward<SolveT>(solve), window);
+  }
+}
+
+#endif
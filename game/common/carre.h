@@ -3,6 +3,7 @@
 #define CARRE_H
 
 #include <array>
+#include <functional>
 #include <numeric>
 
 namespace tda {
@@ -21,6 +22,18 @@ namespace tda {
     auto operator<=>(const Coord& rhs) const = default;
   };
 
+  // Indexeur dense d'une grille N x N : Coord -> X * N + Y
+  template<size_t N>
+  struct CoordIndexer {
+    constexpr size_t operator()(const Coord& c) const noexcept {
+      return ((c.X < N) && (c.Y < N)) ? (c.X * N + c.Y) : size();
+    }
+
+    constexpr static size_t size() noexcept {
+      return N * N;
+    }
+  };
+
   template<size_t N>
   constexpr std::array<size_t, N> ValueEnum = [] {
       std::array<size_t, N> Init;
@@ -29,4 +42,11 @@ namespace tda {
     }();
 }
 
+template<>
+struct std::hash<tda::Coord> {
+  size_t operator()(const tda::Coord& c) const noexcept {
+    return std::hash<size_t>{}(c.X) ^ (std::hash<size_t>{}(c.Y) * 0x9E3779B97F4A7C15ULL);
+  }
+};
+
 #endif
\ No newline at end of file
@@ -6,31 +6,50 @@
 #include <type_traits>
 #include <functional>
 #include <set>
-#include <list>
 #include <map>
+#include <limits>
+#include <deque>
 #include <vector>
 #include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <optional>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include "domainPolicy.h"
+#include "variableStore.h"
+#include "workStealingPool.h"
+#include "solverStatistics.h"
+#include "levelSet.h"
+#include "recordStack.h"
 
 namespace solver
 {
 
-  // Une variable est définie par deux types :
+  // Une variable est définie par trois types :
   // - un indice : L'indice doit être unique et ordonné (trie)
-  // - un domaine : Le domaine est constitué de valeur unique et ordonnée (trie)
+  // - une valeur : Les valeurs du domaine sont uniques et ordonnées (trie)
+  // - une politique de domaine : std::set par défaut (SetDomain), masque de bits pour les petits intervalles (BitsetDomain)
 
-  // Utilisation du type std::set car le nombre de valeurs constituant le domaine est supposé inférieur à 100.
-  // Utilisation du concept std::totally_ordered en adéquation avec l'utilisation std::set
+  // Le solveur range les variables dans un magasin :
+  // - dense (tableau contigu, accès O(1)) si un indexeur de l'indice est fourni (ex: tda::CoordIndexer<N>)
+  // - haché si l'indice dispose de std::hash, ordonné (std::map) sinon
 
-  template <class T>
-  concept ordered_value = std::totally_ordered<T> and (std::is_integral_v<T> or std::is_enum_v<T>);
-
-  template <ordered_value ValueT, std::totally_ordered IndiceT>
+  template <ordered_value ValueT, std::totally_ordered IndiceT, domain_policy<ValueT> DomainT = SetDomain<ValueT>>
   class Variable
   {
   public:
     using indice_t = IndiceT;
     using value_t = ValueT;
-    using domain_t = std::set<ValueT>;
+    using domain_t = DomainT;
 
     Variable(const indice_t indice, const domain_t &domain)
         : Indice(indice), Domain(domain)
@@ -44,7 +63,7 @@ namespace solver
 
     bool isCompromised() const
     {
-      return (Domain.size() == 0U);
+      return Domain.empty();
     }
 
     size_t domainSize() const
@@ -64,13 +83,17 @@ namespace solver
 
     void set(const value_t value)
     {
-      Domain.clear();
+      Domain.assign(value);
+    }
+
+    void restore(const value_t value)
+    {
       Domain.insert(value);
     }
 
     bool canBe(const value_t value) const
     {
-      return Domain.find(value) != Domain.cend();
+      return Domain.contains(value);
     }
 
     value_t value() const
@@ -79,7 +102,7 @@ namespace solver
       {
         throw std::out_of_range("Variable is compromised.");
       }
-      return *(Domain.begin());
+      return Domain.min();
     }
 
     indice_t indice() const
@@ -92,21 +115,293 @@ namespace solver
     domain_t Domain;
   };
 
-  template <ordered_value ValueT, std::totally_ordered IndiceT>
+  // Mode de sauvegarde du contexte à chaque point de choix :
+  // - Copy : copie complète des variables restant à traiter (record_t)
+  // - Trail : journalisation des seules valeurs exclues depuis le point de choix, annulées lors du retour arrière
+  enum class BacktrackMode
+  {
+    Copy,
+    Trail
+  };
+
+  // Evénements de modification d'un domaine auxquels un propagateur peut s'abonner :
+  // - Instantiated : le domaine est réduit à une seule valeur
+  // - BoundsChanged : la plus petite ou la plus grande valeur du domaine a été retirée
+  // - DomainChanged : une valeur quelconque du domaine a été retirée
+  enum class Event : unsigned
+  {
+    None = 0U,
+    Instantiated = 1U,
+    BoundsChanged = 2U,
+    DomainChanged = 4U
+  };
+
+  constexpr Event operator|(const Event lhs, const Event rhs)
+  {
+    return static_cast<Event>(static_cast<unsigned>(lhs) | static_cast<unsigned>(rhs));
+  }
+
+  constexpr bool intersects(const Event lhs, const Event rhs)
+  {
+    return (static_cast<unsigned>(lhs) & static_cast<unsigned>(rhs)) != 0U;
+  }
+
+  // Paquet de contraintes globales connues à la compilation.
+  // Chaque contrainte est un objet fonction bool(solver_t&, indice_t, value_t), par exemple une lambda générique
+  // [](auto& solver, const indice_t, const value_t) {...}. Rangées dans un tuple, les contraintes sont appelées
+  // sans effacement de type et peuvent être intégrées par le compilateur dans la boucle de propagation.
+  template <class... FctT>
+  struct StaticConstraints
+  {
+    static constexpr size_t Size = sizeof...(FctT);
+
+    std::tuple<std::decay_t<FctT>...> Fcts;
+  };
+
+  template <class T>
+  struct is_static_constraints : std::false_type
+  {
+  };
+
+  template <class... FctT>
+  struct is_static_constraints<StaticConstraints<FctT...>> : std::true_type
+  {
+  };
+
+  // Heuristique de choix de la variable à chaque point de choix :
+  // - Comparator : plus petite variable selon le comparateur utilisateur (première variable à défaut)
+  // - Dom : plus petit domaine
+  // - DomDeg : plus petit rapport taille du domaine / nombre de contraintes portant sur la variable
+  // - DomWdeg : idem, chaque contrainte étant pondérée par le nombre d'échecs qu'elle a provoqués
+  // - Impact : plus petit domaine pondéré par la réduction moyenne de l'espace de recherche observée
+  //   lors des choix précédents sur la variable
+  // Hors Comparator, les variables sont rangées dans un tas mis à jour à chaque modification de domaine :
+  // le choix coûte O(log n) au lieu d'un tri complet.
+  enum class Heuristic
+  {
+    Comparator,
+    Dom,
+    DomDeg,
+    DomWdeg,
+    Impact
+  };
+
+  // Stratégie de redémarrage de la recherche d'une solution : la recherche repart de la racine après un nombre
+  // d'échecs qui croît selon la suite de Luby (1, 1, 2, 1, 1, 2, 4, ...) ou géométriquement.
+  // Les poids des heuristiques et les nogoods sont conservés d'un redémarrage à l'autre.
+  enum class Restart
+  {
+    None,
+    Luby,
+    Geometric
+  };
+
+  // Issue de la dernière recherche : Unknown si un budget (noeuds, temps) a été épuisé avant la fin de la recherche
+  enum class SearchStatus
+  {
+    Satisfiable,
+    Unsatisfiable,
+    Unknown
+  };
+
+  template <ordered_value ValueT, std::totally_ordered IndiceT, domain_policy<ValueT> DomainT = SetDomain<ValueT>, class IndexerT = void, class PackT = StaticConstraints<>>
+    requires (std::is_void_v<IndexerT> or indexer<IndexerT, IndiceT>) and is_static_constraints<PackT>::value
   class ConstraintSolver
   {
   public:
     using value_t = ValueT;
     using indice_t = IndiceT;
-    using solver_t = ConstraintSolver<ValueT, IndiceT>;
-    using variable_t = Variable<value_t, indice_t>;
+    using solver_t = ConstraintSolver<ValueT, IndiceT, DomainT, IndexerT, PackT>;
+    using variable_t = Variable<value_t, indice_t, DomainT>;
     using domain_t = variable_t::domain_t;
     using solution_t = std::vector<variable_t>;
     using solution_list_t = std::vector<solution_t>;
 
+    // Vue sur la solution courante : les variables sont consultées dans l'ordre de leurs traitements
+    // sans être copiées. La vue n'est valide que pendant l'appel du visiteur.
+    class solution_view_t
+    {
+    public:
+      using pointer_list_t = std::vector<const variable_t *>;
+
+      class const_iterator
+      {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = variable_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const variable_t *;
+        using reference = const variable_t &;
+
+        const_iterator() = default;
+
+        explicit const_iterator(typename pointer_list_t::const_iterator it)
+            : It(it)
+        {
+        }
+
+        reference operator*() const
+        {
+          return **It;
+        }
+
+        pointer operator->() const
+        {
+          return *It;
+        }
+
+        const_iterator &operator++()
+        {
+          ++It;
+          return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+          const_iterator copy = *this;
+          ++It;
+          return copy;
+        }
+
+        bool operator==(const const_iterator &rhs) const = default;
+
+      private:
+        typename pointer_list_t::const_iterator It;
+      };
+
+      solution_view_t(const solver_t &solver, const pointer_list_t &variables)
+          : Solver(solver), Variables(variables)
+      {
+      }
+
+      size_t size() const
+      {
+        return Variables.size();
+      }
+
+      const variable_t &operator[](const size_t position) const
+      {
+        return *(Variables[position]);
+      }
+
+      // Accès par indice (nullptr si la variable n'existe pas)
+      const variable_t *find(const indice_t &indice) const
+      {
+        return Solver.find(indice);
+      }
+
+      const_iterator begin() const
+      {
+        return const_iterator{Variables.begin()};
+      }
+
+      const_iterator end() const
+      {
+        return const_iterator{Variables.end()};
+      }
+
+      // Copie de la solution pour la conserver au-delà de l'appel du visiteur
+      solution_t copy() const
+      {
+        solution_t solution;
+        solution.reserve(Variables.size());
+        for (const variable_t *var : Variables)
+        {
+          solution.push_back(*var);
+        }
+        return solution;
+      }
+
+    private:
+      const solver_t &Solver;
+      const pointer_list_t &Variables;
+    };
+
+    // Nombre de contraintes globales du paquet statique
+    static constexpr size_t StaticConstraintCount = PackT::Size;
+
     ConstraintSolver()
+        : ConstraintSolver(PackT{})
+    {
+    }
+
+    // Le paquet statique occupe le premier propagateur : une seule entrée dans la file par variable instanciée
+    explicit ConstraintSolver(PackT pack)
+        : Pack(std::move(pack))
     {
+      if constexpr (StaticConstraintCount > 0U)
+      {
+        GlobalWatchers.push_back(0U);
+        Propagators.push_back(propagator_t{nullptr, {}, Event::Instantiated, false});
+      }
       IsSolveInProgress = false;
+      Mode = BacktrackMode::Copy;
+      BackupMemory = 0U;
+      CurrentPropagator = NoPropagator;
+      QueueHead = 0U;
+      ThreadCount = 1U;
+      Parallel = nullptr;
+      WorkerId = 0U;
+      Collect = CollectMode::Store;
+      SolutionLimit = 0U;
+      SolutionCount = 0U;
+      Order = Heuristic::Comparator;
+      HeapDirty = false;
+      GlobalWeight = GlobalWatchers.size();
+      ImpactIndice = std::nullopt;
+      ImpactSpace = 0.0;
+      Backjumping = false;
+      NogoodCapacity = DefaultNogoodCapacity;
+      Explaining = false;
+      ConflictValid = false;
+      Restarts = Restart::None;
+      RestartScale = DefaultRestartScale;
+      RestartFactor = DefaultRestartFactor;
+      RestartsActive = false;
+      RestartIndex = 0U;
+      RestartFailures = 0U;
+      RestartLimit = 0U;
+      Randomize = false;
+      Seed = 0U;
+      NodeLimit = 0U;
+      TimeLimit = std::chrono::milliseconds::zero();
+      SearchStartNodes = 0U;
+      OutOfBudget = false;
+      Status = SearchStatus::Unknown;
+      HasInitial = false;
+      Reloadable = false;
+      Decomposition = false;
+    }
+
+    // Nombre de fils d'exécution de la recherche (1 : recherche séquentielle)
+    void
+    setThreadCount(const size_t threads)
+    {
+      if (!IsSolveInProgress)
+      {
+        ThreadCount = std::max<size_t>(threads, 1U);
+      }
+    }
+
+    size_t
+    threadCount() const
+    {
+      return ThreadCount;
+    }
+
+    void
+    setBacktrackMode(const BacktrackMode mode)
+    {
+      if (!IsSolveInProgress)
+      {
+        Mode = mode;
+      }
+    }
+
+    BacktrackMode
+    backtrackMode() const
+    {
+      return Mode;
     }
 
     template <typename FctT>
@@ -116,6 +411,21 @@ namespace solver
       Comparator = std::forward<FctT>(fct);
     }
 
+    void
+    setHeuristic(const Heuristic heuristic)
+    {
+      if (!IsSolveInProgress)
+      {
+        Order = heuristic;
+      }
+    }
+
+    Heuristic
+    heuristic() const
+    {
+      return Order;
+    }
+
     template <typename FctT>
     void
     setSelector(FctT &&fct)
@@ -123,22 +433,163 @@ namespace solver
       Selector = std::forward<FctT>(fct);
     }
 
+    // Retour arrière dirigé par les conflits : chaque exclusion est expliquée par l'ensemble des niveaux de décision
+    // dont elle dépend, un échec fait remonter directement au dernier point de choix impliqué dans le conflit
+    // et le conflit est mémorisé sous forme de nogood (combinaison de choix interdite).
+    // Les explications supposent qu'un propagateur ne déduit qu'à partir des variables qu'il reçoit :
+    // la variable instanciée pour une contrainte globale, ses variables surveillées pour un propagateur.
+    void
+    setBackjumping(const bool enabled)
+    {
+      if (!IsSolveInProgress)
+      {
+        Backjumping = enabled;
+      }
+    }
+
+    bool
+    backjumping() const
+    {
+      return Backjumping;
+    }
+
+    // Nombre maximum de nogoods conservés (les plus anciens sont oubliés en premier, 0 : aucun apprentissage)
+    void
+    setNogoodCapacity(const size_t capacity)
+    {
+      if (!IsSolveInProgress)
+      {
+        NogoodCapacity = capacity;
+      }
+    }
+
+    size_t
+    nogoodCapacity() const
+    {
+      return NogoodCapacity;
+    }
+
+    // Redémarrages après scale échecs pondérés par la stratégie (factor : raison de la suite géométrique).
+    // Seule la recherche séquentielle d'une solution redémarre, l'énumération des solutions n'est jamais redémarrée.
+    void
+    setRestarts(const Restart strategy, const size_t scale = DefaultRestartScale, const double factor = DefaultRestartFactor)
+    {
+      if (!IsSolveInProgress)
+      {
+        Restarts = strategy;
+        RestartScale = std::max<size_t>(scale, 1U);
+        RestartFactor = std::max(factor, 1.0);
+      }
+    }
+
+    // Départage aléatoire des variables de même priorité et choix aléatoire de la valeur (sans sélecteur)
+    void
+    setRandomization(const bool enabled, const std::uint64_t seed = 0U)
+    {
+      if (!IsSolveInProgress)
+      {
+        Randomize = enabled;
+        Seed = seed;
+        Random.seed(seed);
+      }
+    }
+
+    // Recherche d'une solution par sous-problèmes indépendants : à chaque point fixe, les variables non instanciées
+    // sont partagées en composantes connexes du graphe des contraintes (voir setNeighbourhood) et chaque composante
+    // est résolue séparément. L'échec d'une composante conclut sans revenir sur les choix des autres composantes :
+    // le travail est la somme de celui des parties et non leur produit. Les composantes de la racine sont réparties
+    // entre les fils d'exécution (setThreadCount). La recherche suit le comparateur et le sélecteur, sans tas,
+    // explication ni redémarrage ; solveAll() et les modèles qui créent des variables gardent la recherche ordinaire.
+    void
+    setDecomposition(const bool enabled)
+    {
+      if (!IsSolveInProgress)
+      {
+        Decomposition = enabled;
+      }
+    }
+
+    bool
+    decomposition() const
+    {
+      return Decomposition;
+    }
+
+    // Conserve l'état des variables au début de chaque recherche pour reload(). Le magasin de variables est alors copié
+    // à chaque recherche : sans reload(), cette copie n'est pas faite.
+    void
+    setReloadable(const bool enabled)
+    {
+      if (!IsSolveInProgress)
+      {
+        Reloadable = enabled;
+      }
+    }
+
+    bool
+    reloadable() const
+    {
+      return Reloadable;
+    }
+
+    // Budgets de la recherche : nombre de points de choix et durée (0 : aucune limite).
+    // Une recherche interrompue par un budget se termine avec le statut SearchStatus::Unknown.
+    void
+    setNodeLimit(const size_t nodes)
+    {
+      if (!IsSolveInProgress)
+      {
+        NodeLimit = nodes;
+      }
+    }
+
+    void
+    setTimeLimit(const std::chrono::milliseconds duration)
+    {
+      if (!IsSolveInProgress)
+      {
+        TimeLimit = duration;
+      }
+    }
+
+    SearchStatus
+    status() const
+    {
+      return Status;
+    }
+
+    // Contrainte globale : appelée pour chaque variable nouvellement instanciée
     template <typename FctT>
     void
     addConstraint(FctT &&fct)
     {
-      Constraints.push_back(
-          std::forward<FctT>(fct));
+      ++GlobalWeight;
+      GlobalWatchers.push_back(Propagators.size());
+      Propagators.push_back(
+          propagator_t{std::forward<FctT>(fct), {}, Event::Instantiated, false});
+    }
+
+    // Propagateur : appelé uniquement lorsqu'une des variables surveillées subit l'un des événements.
+    // Abonné au seul événement Instantiated, il est appelé pour chaque variable instanciée.
+    // Sinon il n'est placé qu'une fois dans la file jusqu'à son exécution et reçoit la première variable modifiée.
+    // Tout propagateur abonné à d'autres événements qu'Instantiated est exécuté au démarrage de la recherche.
+    template <typename FctT>
+    void
+    addConstraint(FctT &&fct, const std::vector<indice_t> &watched, const Event events)
+    {
+      Propagators.push_back(
+          propagator_t{std::forward<FctT>(fct), watched, events, false});
     }
 
     template<class It>
     bool
     addVariable(It first, It last, const indice_t &indice)
     {
-      const bool success = Variables.insert(std::make_pair(indice, variable_t{indice, std::set<value_t>{first, last}})).second;
+      const bool success = Variables.insert(node_t{variable_t{indice, domain_t{first, last}}});
       if (success && IsSolveInProgress)
       {
         AdditionalIndices.push_back(indice);
+        watch(*Variables.find(indice));
       }
       return success;
     }
@@ -153,17 +604,23 @@ namespace solver
     exclude(const value_t value, const indice_t &indice)
     {
       bool success = false;
-      if (auto &&it = Variables.find(indice); it != Variables.end())
+      if (node_t *var = Variables.find(indice); var != nullptr)
       {
-        variable_t &var = it->second;
-        if (!var.isInstantiated() && !var.isCompromised())
+        if (!var->isInstantiated() && !var->isCompromised())
         {
-          var.exclude(value);
+          remove(*var, value);
           success = true;
         }
         else
         {
-          success = !(var.canBe(value));
+          success = !(var->canBe(value));
+          if (!success && Backjumping && IsSolveInProgress && !ConflictValid)
+          {
+            // Le conflit dépend de la variable et de ce qui a motivé l'exclusion
+            Conflict = Explaining ? Explanation : LevelSet{};
+            Conflict.merge(var->Reasons);
+            ConflictValid = true;
+          }
         }
       }
       return success;
@@ -179,21 +636,27 @@ namespace solver
     bool
     exists(const indice_t &indice) const
     {
-      auto &&it = Variables.find(indice);
-      return (it != Variables.end());
+      return (Variables.find(indice) != nullptr);
     }
 
     variable_t
     get(const indice_t &indice) const
     {
       variable_t var(indice, {});
-      if (auto &&it = Variables.find(indice); it != Variables.cend())
+      if (const variable_t *found = Variables.find(indice); found != nullptr)
       {
-        var = it->second;
+        var = *found;
       }
       return var;
     }
 
+    // Accès sans copie à une variable (nullptr si elle n'existe pas)
+    const variable_t *
+    find(const indice_t &indice) const
+    {
+      return Variables.find(indice);
+    }
+
     size_t solutionsSize() const
     {
       return SolutionList.size();
@@ -204,260 +667,2898 @@ namespace solver
       return SolutionList;
     }
 
-    bool solve()
+    // Nombre de points de choix créés depuis la construction du solveur
+    size_t choicePoints() const
     {
-      return internSolve(false);
+      return ChoicePointCount;
     }
 
-    void solveAll()
+    // Mémoire moyenne (octets) sauvegardée par point de choix pour le retour arrière
+    size_t memoryPerNode() const
     {
-      internSolve(true);
+      return (ChoicePointCount == 0U) ? 0U : (BackupMemory / ChoicePointCount);
     }
 
-  private:
-    using constraint_t = std::function<bool(solver_t&, const indice_t, const value_t)>;
-    using comparator_t = std::function<bool(const variable_t&, const variable_t&)>;
-    using selector_t = std::function<value_t(const variable_t&)>;
-    using map_variable_t = std::map<indice_t,variable_t>;
-    using list_cref_variable_t = std::vector<std::reference_wrapper<variable_t>>;
-    using vector_variable_t = std::vector<variable_t>;
-    using list_indice_t = std::vector<indice_t>;
-    using set_indice_t = std::set<indice_t>;
-    struct record_t
-    {
-      list_indice_t Register;
-      vector_variable_t RemainingVariables;
-      indice_t ChoiceIndice;
-      value_t ChoiceValue;
-    };
-    using record_list_t = std::list<record_t>;
-    struct parameters_t
+    // Nombre d'appels de contraintes depuis la construction du solveur
+    size_t propagations() const
     {
-      list_cref_variable_t Processing;
-      list_indice_t Register;
-      record_list_t Backup;
-    };
+      return PropagationCount;
+    }
 
-    bool
-    internSolve(const bool all)
+    // Compteurs de la recherche, lisibles pendant la recherche depuis un autre fil.
+    // Les contraintes sont numérotées dans l'ordre de leur ajout (le paquet statique, s'il existe, est la contrainte 0).
+    // En recherche parallèle, les compteurs des fils sont cumulés à la fin de la recherche.
+    SolverStatistics statistics() const
     {
-      // Démarrage de la recherche de solution
-      IsSolveInProgress = true;
-
-      // Initialisation des données
-      bool nextSolution = true;
-      parameters_t parameters;
+      SolverStatistics stats;
+      stats.Nodes = ChoicePointCount;
+      stats.Propagations = PropagationCount;
+      stats.MemoryPerNode = memoryPerNode();
+      stats.Failures = FailureCount;
+      stats.Backtracks = BacktrackCount;
+      stats.Exclusions = ExclusionCount;
+      stats.Solutions = FoundCount;
+      stats.PeakBackup = PeakBackup;
+      stats.Backjumps = BackjumpCount;
+      stats.Nogoods = NogoodCount;
+      stats.Restarts = RestartCount;
+      stats.Constraints.reserve(Propagators.size());
+      for (const propagator_t &propagator : Propagators)
+      {
+        stats.Constraints.push_back(ConstraintStatistics{propagator.Counters.Calls, propagator.Counters.Failures,
+                                                         propagator.Counters.Exclusions,
+                                                         std::chrono::nanoseconds(propagator.Counters.Time.get())});
+      }
+      return stats;
+    }
 
-      // Initialisation des variables utilisées pour la recherche de solution
-      parameters.Processing.reserve(Variables.size());
-      parameters.Register.reserve(Variables.size());
-      for(auto &&var: Variables)
+    void resetStatistics()
+    {
+      ChoicePointCount = Counter{};
+      PropagationCount = Counter{};
+      BackupMemory = 0U;
+      FailureCount = Counter{};
+      BacktrackCount = Counter{};
+      ExclusionCount = Counter{};
+      FoundCount = Counter{};
+      PeakBackup = Counter{};
+      BackjumpCount = Counter{};
+      NogoodCount = Counter{};
+      RestartCount = Counter{};
+      for (propagator_t &propagator : Propagators)
       {
-        parameters.Processing.push_back(var.second); // Variables en cours de traitement
-        parameters.Register.push_back(var.first);// Indice des variables dans l'ordre de traitement
+        propagator.Counters = constraint_counters_t{};
       }
+    }
 
-      // TANT QUE (des solutions existent) FAIRE 
-      //   rechercher une solution
-      //   si une solution existe, mémoriser la solution est passée à la suivante
-      //   sinon arrêter
-      while (nextSolution)
+    // Oublie l'instance (variables, solutions, nogoods, poids des contraintes) en conservant le modèle :
+    // contraintes, heuristiques, options et mémoire déjà réservée. L'instance suivante est construite par addVariable().
+    // Après quelques instances, la résolution d'une nouvelle instance de même taille n'alloue plus de mémoire,
+    // sauf en recherche parallèle et avec des domaines std::set (SetDomain) : chaque addVariable() alloue alors les noeuds
+    // de son domaine, que la copie de l'état initial (setReloadable) duplique un à un à chaque recherche.
+    void reset()
+    {
+      if (!IsSolveInProgress)
       {
-        // Recherche une solution
-        const bool isSolution = SearchSolution(parameters);
-        // Mémorise la solution
-        if (isSolution)
+        Variables.clear();
+        Initial.clear();
+        HasInitial = false;
+        forget();
+        for (propagator_t &propagator : Propagators)
         {
-          // Recopie des variables en cours de calcul dans l'ordre de leurs traitements
-          solution_t solution;
-          solution.reserve(parameters.Register.size());
-          for(auto &&indice : parameters.Register)
-          {
-            if(auto &&it = Variables.find(indice); it != Variables.cend())
-            {
-              solution.push_back(it->second);
-            }
-          }
-          SolutionList.emplace_back(std::move(solution));
+          propagator.Weight = 1U;
         }
-        // Recherche les autres solutions
-        nextSolution = all && !parameters.Backup.empty() && isSolution;
-      } 
-      IsSolveInProgress = false;
-      return !SolutionList.empty();
+        GlobalWeight = GlobalWatchers.size();
+      }
     }
 
-    bool 
-    SearchSolution(parameters_t& parameters)
+    // Restaure les variables dans leur état précédant la dernière recherche pour résoudre à nouveau la même instance
+    // (avec d'autres options par exemple). Les poids appris par les heuristiques sont conservés.
+    // Sans effet si cette recherche a été lancée sans setReloadable(true).
+    void reload()
     {
-      bool isSolution = false;
-      bool sastified = true;
-      // TANT QUE (la solution n'est pas trouvé et que toutes les contraintes sont sastifaites) FAIRE 
-      //   réduire le nombre de variable constituant le problème et vérifier la cohérence du problème
-      //   si une solution partielle est trouvée, déterminer un point de choix
+      if (!IsSolveInProgress && HasInitial)
+      {
+        Variables = Initial;
+        forget();
+      }
+    }
+
+    bool solve()
+    {
+      return internSolve(false);
+    }
+
+    void solveAll()
+    {
+      internSolve(true);
+    }
+
+    // Recherche de toutes les solutions sans les mémoriser : chaque solution est transmise au visiteur
+    // sous la forme d'une vue (solution_view_t). Le visiteur peut retourner false pour arrêter la recherche.
+    // La recherche s'arrête également après limit solutions (0 : aucune limite).
+    // En recherche parallèle, les appels du visiteur sont sérialisés.
+    // Retourne le nombre de solutions transmises au visiteur.
+    template <typename FctT>
+    size_t solveAll(FctT &&visitor, const size_t limit = 0U)
+    {
+      Visitor = [&visitor](const solution_view_t &solution)
+      {
+        if constexpr (std::is_void_v<std::invoke_result_t<FctT &, const solution_view_t &>>)
+        {
+          visitor(solution);
+          return true;
+        }
+        else
+        {
+          return static_cast<bool>(visitor(solution));
+        }
+      };
+      const size_t count = internCollect(CollectMode::Visit, limit);
+      Visitor = nullptr;
+      return count;
+    }
+
+    // Dénombrement des solutions sans aucune allocation par solution.
+    // Le dénombrement s'arrête après limit solutions (0 : aucune limite),
+    // countSolutions(2U) == 1U vérifie par exemple l'unicité de la solution.
+    size_t countSolutions(const size_t limit = 0U)
+    {
+      return internCollect(CollectMode::Count, limit);
+    }
+
+    // Voisinage des contraintes globales et du paquet statique pour le dénombrement exact :
+    // neighbours(solver, indice, list) ajoute à list les variables liées à indice par ces contraintes
+    // dans l'état courant (une différence entre deux domaines disjoints est toujours satisfaite et ne lie rien).
+    // Sans voisinage, les contraintes globales relient toutes les variables entre elles.
+    template <typename FctT>
+    void
+    setNeighbourhood(FctT &&fct)
+    {
+      Neighbourhood = std::forward<FctT>(fct);
+    }
+
+    // Dénombrement exact par décomposition : à chaque noeud, les variables non instanciées sont partagées
+    // en composantes indépendantes du graphe des contraintes (variables surveillées par un même propagateur,
+    // voisinage des contraintes globales). Chaque composante est dénombrée séparément et les nombres sont multipliés ;
+    // le nombre d'une composante est mémorisé selon l'état de ses domaines et réutilisé lorsque cet état se répète.
+    // Le cache suppose que les contraintes reliant une composante aux variables instanciées sont reflétées
+    // par les domaines, ce que font les règles qui retirent la valeur d'une variable instanciée à ses voisines.
+    // Le dénombrement s'arrête dès limit solutions (0 : aucune limite) et retourne alors limit ; les nombres
+    // saturent à SIZE_MAX. La recherche est séquentielle, les propagateurs ne doivent pas créer de variables,
+    // et les domaines sont restaurés à la fin : aucune solution n'est conservée.
+    size_t countExact(const size_t limit = 0U)
+    {
+      if (IsSolveInProgress)
+      {
+        return 0U;
+      }
+      // Le journal annule chaque choix ; ni tas, ni explication, ni redémarrage
+      const BacktrackMode mode = Mode;
+      const Heuristic order = Order;
+      const bool backjumping = Backjumping;
+      Mode = BacktrackMode::Trail;
+      Order = Heuristic::Comparator;
+      Backjumping = false;
+      OutOfBudget = false;
+      SearchStartNodes = ChoicePointCount;
+      Deadline = std::chrono::steady_clock::now() + TimeLimit;
+      IsSolveInProgress = true;
+      initSearch(Search);
+      size_t count = 0U;
+      if (propagateFixpoint())
+      {
+        count = countComponents(openNodes(Search), (limit == 0U) ? std::numeric_limits<size_t>::max() : limit);
+      }
+      undo(0U);
+      dropAdditional();
+      CountCache.clear();
+      endSearch();
+      Mode = mode;
+      Order = order;
+      Backjumping = backjumping;
+      if (OutOfBudget)
+      {
+        Status = SearchStatus::Unknown;
+      }
+      else
+      {
+        Status = (count > 0U) ? SearchStatus::Satisfiable : SearchStatus::Unsatisfiable;
+      }
+      return count;
+    }
+
+    // Vrai s'il existe plus de k solutions : le dénombrement s'arrête à k + 1
+    bool moreSolutionsThan(const size_t k)
+    {
+      return countExact(k + 1U) > k;
+    }
+
+  private:
+    using constraint_t = std::function<bool(solver_t&, const indice_t, const value_t)>;
+    using neighbourhood_t = std::function<void(const solver_t &, const indice_t &, std::vector<indice_t> &)>;
+    using comparator_t = std::function<bool(const variable_t&, const variable_t&)>;
+    using selector_t = std::function<value_t(const variable_t&)>;
+    static constexpr size_t NoPropagator = static_cast<size_t>(-1);
+    static constexpr size_t DefaultNogoodCapacity = 256U;
+    // Les conflits plus longs sont trop spécifiques pour être réutilisés
+    static constexpr size_t NogoodMaxLength = 32U;
+    static constexpr size_t DefaultRestartScale = 100U;
+    static constexpr double DefaultRestartFactor = 1.5;
+    // Nombres de composantes mémorisés par le dénombrement exact
+    static constexpr size_t CountCacheCapacity = 1U << 16U;
+    static constexpr size_t NoSlot = static_cast<size_t>(-1);
+    struct constraint_counters_t
+    {
+      Counter Calls;
+      Counter Failures;
+      Counter Exclusions;
+      Counter Time;
+    };
+    struct propagator_t
+    {
+      constraint_t Fct;
+      std::vector<indice_t> Watched;
+      Event Events;
+      bool Queued;
+      // Nombre d'échecs provoqués (+1), utilisé par l'heuristique DomWdeg
+      size_t Weight = 1U;
+      constraint_counters_t Counters = {};
+    };
+    struct watch_t
+    {
+      size_t Propagator;
+      Event Events;
+    };
+    // Variable rangée dans le magasin, avec la liste des propagateurs qui la surveillent
+    struct node_t : variable_t
+    {
+      explicit node_t(const variable_t &var)
+          : variable_t(var)
+      {
+      }
+
+      std::vector<watch_t> Watchers;
+      // Version de la clé de la variable dans le tas des heuristiques
+      size_t Stamp = 0U;
+      bool Touched = false;
+      // Réduction moyenne de l'espace de recherche provoquée par les choix sur la variable
+      double ImpactSum = 0.0;
+      size_t ImpactCount = 0U;
+      // Niveaux de décision expliquant les exclusions du domaine (retour arrière dirigé par les conflits)
+      LevelSet Reasons;
+      // Rang de la variable pendant le partage en composantes (dénombrement exact)
+      size_t Slot = NoSlot;
+    };
+    struct heap_entry_t
+    {
+      double Key;
+      // Départage aléatoire des clés égales (0 sans randomisation)
+      std::uint64_t Tie;
+      size_t Stamp;
+      indice_t Indice;
+    };
+    struct event_item_t
+    {
+      size_t Propagator;
+      node_t* Node;
+    };
+    using store_variable_t = variable_store_t<node_t, IndexerT>;
+    using list_cref_variable_t = std::vector<std::reference_wrapper<variable_t>>;
+    using vector_variable_t = std::vector<variable_t>;
+    using list_indice_t = std::vector<indice_t>;
+    using set_indice_t = std::set<indice_t>;
+    // Etat canonique d'une composante : indices triés, taille et valeurs de chaque domaine
+    using count_key_t = std::tuple<list_indice_t, std::vector<size_t>, std::vector<value_t>>;
+    struct record_t
+    {
+      // Mode Copy
+      list_indice_t Register;
+      vector_variable_t RemainingVariables;
+      // Mode Trail
+      size_t RegisterSize;
+      size_t TrailSize;
+      size_t DetachedSize;
+      // Recherche parallèle
+      size_t PathSize;
+      indice_t ChoiceIndice;
+      value_t ChoiceValue;
+    };
+    using record_list_t = RecordStack<record_t>;
+    struct trail_entry_t
+    {
+      variable_t* Variable;
+      value_t Value;
+    };
+    using trail_t = std::vector<trail_entry_t>;
+    // Décision du chemin menant à un sous-arbre : affectation (var = val) ou exclusion (var != val)
+    struct decision_t
+    {
+      indice_t Indice;
+      value_t Value;
+      bool Assign;
+    };
+    using path_t = std::vector<decision_t>;
+    // Combinaison d'affectations interdite, apprise d'un conflit
+    struct literal_t
+    {
+      indice_t Indice;
+      value_t Value;
+    };
+    using nogood_t = std::vector<literal_t>;
+    // Données partagées par les fils d'exécution de la recherche parallèle
+    struct parallel_t
+    {
+      explicit parallel_t(const size_t workers)
+          : Pool(workers), Winner(workers)
+      {
+      }
+
+      // Le premier fil ayant trouvé une solution arrête la recherche
+      void
+      claim(const size_t worker)
+      {
+        bool expected = false;
+        if (Found.compare_exchange_strong(expected, true))
+        {
+          Winner = worker;
+          Pool.stop();
+        }
+      }
+
+      WorkStealingPool<path_t> Pool;
+      std::atomic<bool> Found{false};
+      size_t Winner;
+      // Rang des solutions trouvées par l'ensemble des fils et sérialisation du visiteur
+      std::atomic<size_t> Count{0U};
+      std::mutex VisitorMutex;
+      // Points de choix de l'ensemble des fils (budget de noeuds)
+      std::atomic<size_t> Nodes{0U};
+    };
+    // Traitement des solutions trouvées : mémorisation, visite ou simple dénombrement
+    enum class CollectMode
+    {
+      Store,
+      Visit,
+      Count
+    };
+    using visitor_t = std::function<bool(const solution_view_t &)>;
+    struct parameters_t
+    {
+      list_cref_variable_t Processing;
+      list_cref_variable_t Detached;
+      list_indice_t Register;
+      record_list_t Backup;
+    };
+
+    bool
+    internSolve(const bool all)
+    {
+      // Etat initial des variables, restauré par reload()
+      if (Reloadable)
+      {
+        Initial = Variables;
+      }
+      else if (HasInitial)
+      {
+        Initial.clear();
+      }
+      HasInitial = Reloadable;
+      const size_t found = SolutionCount;
+      OutOfBudget = false;
+      SearchStartNodes = ChoicePointCount;
+      Deadline = std::chrono::steady_clock::now() + TimeLimit;
+      RestartsActive = (Restarts != Restart::None) && !all && (ThreadCount == 1U);
+      RestartIndex = 0U;
+      RestartFailures = 0U;
+      RestartLimit = restartCutoff();
+      bool result = false;
+      if (Decomposition && !all && decomposedSolve())
+      {
+        result = !SolutionList.empty();
+      }
+      else if (ThreadCount > 1U)
+      {
+        result = parallelSolve(all);
+      }
+      else
+      {
+        // Démarrage de la recherche de solution
+        IsSolveInProgress = true;
+
+        // Initialisation des données
+        initSearch(Search);
+        searchSolutions(Search, all);
+        endSearch();
+        result = !SolutionList.empty();
+      }
+      const bool satisfiable = (SolutionCount > found);
+      if (satisfiable && !all)
+      {
+        Status = SearchStatus::Satisfiable;
+      }
+      else if (OutOfBudget)
+      {
+        Status = SearchStatus::Unknown;
+      }
+      else
+      {
+        Status = satisfiable ? SearchStatus::Satisfiable : SearchStatus::Unsatisfiable;
+      }
+      return result;
+    }
+
+    size_t
+    internCollect(const CollectMode collect, const size_t limit)
+    {
+      Collect = collect;
+      SolutionLimit = limit;
+      SolutionCount = 0U;
+      internSolve(true);
+      Collect = CollectMode::Store;
+      SolutionLimit = 0U;
+      return SolutionCount;
+    }
+
+    void
+    initSearch(parameters_t& parameters)
+    {
+      // Initialisation des variables utilisées pour la recherche de solution
+      // (les tampons de la recherche précédente sont réutilisés)
+      parameters.Processing.clear();
+      parameters.Detached.clear();
+      parameters.Register.clear();
+      parameters.Backup.clear();
+      parameters.Processing.reserve(Variables.size());
+      parameters.Register.reserve(Variables.size());
+      Variables.forEach([&parameters](node_t &var)
+      {
+        parameters.Processing.push_back(var); // Variables en cours de traitement
+      });
+      // Traitement dans l'ordre des indices quel que soit le magasin
+      std::sort(parameters.Processing.begin(), parameters.Processing.end(),
+                [](const variable_t &var1, const variable_t &var2)
+                { return var1.indice() < var2.indice(); });
+      for(const variable_t &var: parameters.Processing)
+      {
+        parameters.Register.push_back(var.indice());// Indice des variables dans l'ordre de traitement
+      }
+      // Abonnements des propagateurs et réveil initial
+      watchAll();
+      for (size_t p = 0U; p < Propagators.size(); ++p)
+      {
+        const propagator_t &propagator = Propagators[p];
+        if (propagator.Events != Event::Instantiated)
+        {
+          for (const indice_t &indice : propagator.Watched)
+          {
+            if (node_t *node = Variables.find(indice); node != nullptr)
+            {
+              schedule(p, *node);
+              break;
+            }
+          }
+        }
+      }
+      for(variable_t &var: parameters.Processing)
+      {
+        if (var.isInstantiated())
+        {
+          notify(static_cast<node_t &>(var), Event::Instantiated | Event::BoundsChanged | Event::DomainChanged);
+        }
+      }
+      ImpactIndice = std::nullopt;
+      rebuildHeap(parameters);
+      // Les explications et les nogoods ne valent que pour la recherche en cours (ou la tâche en recherche parallèle)
+      if (Backjumping)
+      {
+        Variables.forEach([](node_t &node)
+        {
+          node.Reasons.clear();
+        });
+        Nogoods.clear();
+        ConflictValid = false;
+      }
+    }
+
+    void
+    searchSolutions(parameters_t& parameters, const bool all)
+    {
+      bool nextSolution = true;
+      // TANT QUE (des solutions existent) FAIRE 
+      //   rechercher une solution
+      //   si une solution existe, mémoriser la solution est passée à la suivante
+      //   sinon arrêter
+      while (nextSolution)
+      {
+        // Recherche une solution
+        const bool isSolution = SearchSolution(parameters);
+        // Mémorise la solution
+        bool more = true;
+        if (isSolution)
+        {
+          more = collect(parameters);
+          if ((Parallel != nullptr) && !all)
+          {
+            Parallel->claim(WorkerId);
+          }
+        }
+        // Recherche les autres solutions
+        nextSolution = all && more && !parameters.Backup.empty() && isSolution;
+      } 
+    }
+
+    // Traite une solution, retourne false si la recherche doit s'arrêter
+    bool
+    collect(const parameters_t &parameters)
+    {
+      size_t rank = SolutionCount;
+      if (Parallel != nullptr)
+      {
+        rank = Parallel->Count++;
+      }
+      if ((SolutionLimit != 0U) && (rank >= SolutionLimit))
+      {
+        stopAll();
+        return false;
+      }
+      if constexpr (StatisticsEnabled)
+      {
+        ++FoundCount;
+      }
+      bool more = true;
+      if (Collect == CollectMode::Count)
+      {
+        ++SolutionCount;
+      }
+      else
+      {
+        // Variables en cours de calcul dans l'ordre de leurs traitements
+        ViewBuffer.clear();
+        for (auto &&indice : parameters.Register)
+        {
+          if (const variable_t *var = Variables.find(indice); var != nullptr)
+          {
+            ViewBuffer.push_back(var);
+          }
+        }
+        const solution_view_t view(*this, ViewBuffer);
+        if (Collect == CollectMode::Store)
+        {
+          // Les solutions oubliées par reset() prêtent leur mémoire aux nouvelles solutions
+          solution_t solution;
+          if (!SpareSolutions.empty())
+          {
+            solution = std::move(SpareSolutions.back());
+            SpareSolutions.pop_back();
+            solution.clear();
+          }
+          solution.reserve(ViewBuffer.size());
+          for (const variable_t *var : ViewBuffer)
+          {
+            solution.push_back(*var);
+          }
+          SolutionList.push_back(std::move(solution));
+          ++SolutionCount;
+        }
+        else if (Parallel != nullptr)
+        {
+          std::lock_guard<std::mutex> lock(Parallel->VisitorMutex);
+          if (!Parallel->Pool.stopped())
+          {
+            ++SolutionCount;
+            more = Visitor(view);
+          }
+        }
+        else
+        {
+          ++SolutionCount;
+          more = Visitor(view);
+        }
+      }
+      more = more && ((SolutionLimit == 0U) || (rank + 1U < SolutionLimit));
+      if (!more)
+      {
+        stopAll();
+      }
+      return more;
+    }
+
+    // Propagation des recherches décomposées (dénombrement exact, sous-problèmes indépendants),
+    // sans nogood ni intégration de variables
+    bool
+    propagateFixpoint()
+    {
+      bool sastified = true;
+      while (sastified && (QueueHead < Queue.size()))
+      {
+        const event_item_t item = Queue[QueueHead];
+        ++QueueHead;
+        Propagators[item.Propagator].Queued = false;
+        ++PropagationCount;
+        sastified = profile(item);
+      }
+      clearQueue();
+      if (!AdditionalIndices.empty())
+      {
+        // Variables créées par un propagateur : le dénombrement ne peut pas conclure
+        OutOfBudget = true;
+      }
+      return sastified;
+    }
+
+    // Annule les exclusions journalisées au-delà de mark
+    void
+    undo(const size_t mark)
+    {
+      while (Trail.size() > mark)
+      {
+        const trail_entry_t &entry = Trail.back();
+        entry.Variable->restore(entry.Value);
+        Trail.pop_back();
+      }
+    }
+
+    // Supprime les variables créées par les propagateurs pendant une recherche décomposée
+    void
+    dropAdditional()
+    {
+      for (const indice_t &indice : AdditionalIndices)
+      {
+        Variables.erase(indice);
+      }
+      AdditionalIndices.clear();
+    }
+
+    // Variables non instanciées de la recherche
+    static std::vector<node_t *>
+    openNodes(const parameters_t &parameters)
+    {
+      std::vector<node_t *> open;
+      for (variable_t &var : parameters.Processing)
+      {
+        if (!var.isInstantiated())
+        {
+          open.push_back(&static_cast<node_t &>(var));
+        }
+      }
+      return open;
+    }
+
+    // Partage des variables en composantes connexes du graphe des contraintes (union-find),
+    // chaque composante conserve l'ordre des variables reçues
+    std::vector<std::vector<node_t *>>
+    split(const std::vector<node_t *> &vars)
+    {
+      std::vector<size_t> parent(vars.size());
+      for (size_t v = 0U; v < vars.size(); ++v)
+      {
+        parent[v] = v;
+        vars[v]->Slot = v;
+      }
+      const auto root = [&parent](size_t v)
+      {
+        while (parent[v] != v)
+        {
+          parent[v] = parent[parent[v]];
+          v = parent[v];
+        }
+        return v;
+      };
+      // nombre de composantes restantes : le partage s'arrête dès qu'il n'en reste qu'une
+      size_t remaining = vars.size();
+      const auto unite = [&parent, &root, &remaining](const size_t a, const size_t b)
+      {
+        const size_t ra = root(a);
+        const size_t rb = root(b);
+        if (ra != rb)
+        {
+          parent[std::max(ra, rb)] = std::min(ra, rb);
+          --remaining;
+        }
+      };
+      for (size_t p = 0U; (p < Propagators.size()) && (remaining > 1U); ++p)
+      {
+        size_t first = NoSlot;
+        for (const indice_t &indice : Propagators[p].Watched)
+        {
+          if (const node_t *node = Variables.find(indice); (node != nullptr) && (node->Slot != NoSlot))
+          {
+            if (first == NoSlot)
+            {
+              first = node->Slot;
+            }
+            else
+            {
+              unite(first, node->Slot);
+            }
+          }
+        }
+      }
+      if (!GlobalWatchers.empty() && (remaining > 1U))
+      {
+        if (Neighbourhood)
+        {
+          for (size_t v = 0U; (v < vars.size()) && (remaining > 1U); ++v)
+          {
+            NeighbourBuffer.clear();
+            Neighbourhood(*this, vars[v]->indice(), NeighbourBuffer);
+            for (const indice_t &indice : NeighbourBuffer)
+            {
+              if (const node_t *node = Variables.find(indice); (node != nullptr) && (node->Slot != NoSlot))
+              {
+                unite(v, node->Slot);
+              }
+            }
+          }
+        }
+        else
+        {
+          remaining = 1U;
+        }
+      }
+      std::vector<std::vector<node_t *>> components;
+      std::vector<size_t> component(vars.size(), NoSlot);
+      for (size_t v = 0U; v < vars.size(); ++v)
+      {
+        const size_t r = (remaining > 1U) ? root(v) : 0U;
+        if (component[r] == NoSlot)
+        {
+          component[r] = components.size();
+          components.emplace_back();
+        }
+        components[component[r]].push_back(vars[v]);
+        vars[v]->Slot = NoSlot;
+      }
+      return components;
+    }
+
+    // Nombre de solutions des variables non instanciées vars, limité à cap : produit des composantes
+    size_t
+    countComponents(const std::vector<node_t *> &vars, const size_t cap)
+    {
+      if (vars.empty())
+      {
+        return 1U;
+      }
+      std::vector<std::vector<node_t *>> components = split(vars);
+      // Les petites composantes d'abord : une composante sans solution arrête le produit au plus tôt
+      std::stable_sort(components.begin(), components.end(),
+                       [](const std::vector<node_t *> &lhs, const std::vector<node_t *> &rhs)
+                       { return lhs.size() < rhs.size(); });
+      // Un état ne se répète guère qu'à travers les composantes issues d'un partage : seules celles-ci sont mémorisées
+      const bool cached = (components.size() > 1U);
+      size_t product = 1U;
+      for (auto it = components.begin(); (it != components.end()) && (product != 0U) && !isStopped(); ++it)
+      {
+        const size_t count = countComponent(*it, cap, cached);
+        product = ((count != 0U) && (product > cap / count)) ? cap : std::min(product * count, cap);
+      }
+      return product;
+    }
+
+    // Nombre de solutions d'une composante connexe, limité à cap
+    size_t
+    countComponent(const std::vector<node_t *> &vars, const size_t cap, const bool cached)
+    {
+      count_key_t key;
+      if (cached)
+      {
+        auto &[indices, sizes, values] = key;
+        for (const node_t *node : vars)
+        {
+          indices.push_back(node->indice());
+          sizes.push_back(node->domainSize());
+          values.insert(values.end(), node->domain().begin(), node->domain().end());
+        }
+        if (auto it = CountCache.find(key); it != CountCache.end())
+        {
+          return std::min(it->second, cap);
+        }
+      }
+      // Variable de plus petit domaine, la première en cas d'égalité
+      node_t *choice = *std::min_element(vars.begin(), vars.end(), [](const node_t *lhs, const node_t *rhs)
+                                         { return lhs->domainSize() < rhs->domainSize(); });
+      const std::vector<value_t> candidates(choice->domain().begin(), choice->domain().end());
+      size_t total = 0U;
+      std::vector<node_t *> open;
+      for (auto it = candidates.begin(); (it != candidates.end()) && (total < cap) && !isStopped(); ++it)
+      {
+        ++ChoicePointCount;
+        const size_t mark = Trail.size();
+        assign(*choice, *it);
+        if (propagateFixpoint())
+        {
+          open.clear();
+          for (node_t *node : vars)
+          {
+            if (!node->isInstantiated())
+            {
+              open.push_back(node);
+            }
+          }
+          const size_t count = countComponents(open, cap - total);
+          total = (count >= cap - total) ? cap : (total + count);
+        }
+        undo(mark);
+      }
+      // Seuls les nombres exacts sont mémorisés
+      if (cached && (total < cap) && !OutOfBudget && (CountCache.size() < CountCacheCapacity))
+      {
+        CountCache.emplace(std::move(key), total);
+      }
+      return total;
+    }
+
+    // Recherche d'une solution par sous-problèmes indépendants (journal et comparateur).
+    // Retourne false si un propagateur a créé des variables : l'état initial est rétabli pour la recherche ordinaire.
+    bool
+    decomposedSolve()
+    {
+      const BacktrackMode mode = Mode;
+      const Heuristic order = Order;
+      const bool backjumping = Backjumping;
+      Mode = BacktrackMode::Trail;
+      Order = Heuristic::Comparator;
+      Backjumping = false;
+      IsSolveInProgress = true;
+      initSearch(Search);
+      const bool found = propagateFixpoint() && solveComponents(openNodes(Search), ThreadCount);
+      const bool decomposable = AdditionalIndices.empty();
+      if (found && decomposable)
+      {
+        collect(Search);
+      }
+      else
+      {
+        undo(0U);
+      }
+      if (!decomposable)
+      {
+        dropAdditional();
+        OutOfBudget = false;
+      }
+      endSearch();
+      Mode = mode;
+      Order = order;
+      Backjumping = backjumping;
+      return decomposable;
+    }
+
+    // Résout séparément les composantes connexes des variables non instanciées vars, les plus petites d'abord :
+    // l'échec d'une composante conclut sans revenir sur les choix des autres
+    bool
+    solveComponents(const std::vector<node_t *> &vars, const size_t threads)
+    {
+      if (vars.empty())
+      {
+        return true;
+      }
+      std::vector<std::vector<node_t *>> components = split(vars);
+      std::stable_sort(components.begin(), components.end(),
+                       [](const std::vector<node_t *> &lhs, const std::vector<node_t *> &rhs)
+                       { return lhs.size() < rhs.size(); });
+      if ((threads > 1U) && (components.size() > 1U))
+      {
+        return parallelComponents(components, threads);
+      }
+      bool sastified = true;
+      for (auto it = components.begin(); (it != components.end()) && sastified; ++it)
+      {
+        sastified = !isStopped() && solveComponent(*it);
+      }
+      return sastified;
+    }
+
+    // Solution d'une composante connexe, les choix sont conservés en cas de succès
+    bool
+    solveComponent(const std::vector<node_t *> &vars)
+    {
+      node_t *choice = Comparator ? *std::min_element(vars.begin(), vars.end(), [this](const node_t *lhs, const node_t *rhs)
+                                                      { return Comparator(*lhs, *rhs); })
+                                  : *std::min_element(vars.begin(), vars.end(), [](const node_t *lhs, const node_t *rhs)
+                                                      { return lhs->domainSize() < rhs->domainSize(); });
+      std::vector<value_t> candidates(choice->domain().begin(), choice->domain().end());
+      if (Selector)
+      {
+        // La valeur du sélecteur est essayée en premier
+        if (auto first = std::find(candidates.begin(), candidates.end(), Selector(*choice)); first != candidates.end())
+        {
+          std::rotate(candidates.begin(), first, std::next(first));
+        }
+      }
+      bool found = false;
+      std::vector<node_t *> open;
+      for (auto it = candidates.begin(); (it != candidates.end()) && !found && !isStopped(); ++it)
+      {
+        ++ChoicePointCount;
+        countNode();
+        const size_t mark = Trail.size();
+        assign(*choice, *it);
+        if (propagateFixpoint())
+        {
+          open.clear();
+          for (node_t *node : vars)
+          {
+            if (!node->isInstantiated())
+            {
+              open.push_back(node);
+            }
+          }
+          found = solveComponents(open, 1U);
+        }
+        if (!found)
+        {
+          if constexpr (StatisticsEnabled)
+          {
+            ++BacktrackCount;
+          }
+          undo(mark);
+        }
+      }
+      return found;
+    }
+
+    // Composantes réparties entre des copies du solveur, chaque fil prend la composante suivante.
+    // Le premier échec arrête les autres fils ; en cas de succès, les valeurs trouvées sont recopiées.
+    bool
+    parallelComponents(const std::vector<std::vector<node_t *>> &components, const size_t threads)
+    {
+      const size_t count = std::min(threads, components.size());
+      parallel_t shared(count);
+      std::vector<solver_t> workers(count, *this);
+      for (size_t w = 0U; w < workers.size(); ++w)
+      {
+        // Le journal de la copie désigne les variables du solveur d'origine
+        workers[w].Trail.clear();
+        workers[w].ThreadCount = 1U;
+        workers[w].Parallel = &shared;
+        workers[w].WorkerId = w;
+        workers[w].SolutionList.clear();
+        workers[w].resetStatistics();
+        workers[w].SolutionCount = 0U;
+      }
+      std::atomic<size_t> next{0U};
+      std::atomic<size_t> solved{0U};
+      {
+        std::vector<std::thread> pool;
+        pool.reserve(workers.size());
+        for (solver_t &worker : workers)
+        {
+          pool.emplace_back([&worker, &components, &next, &solved, &shared]()
+          {
+            for (size_t c = next++; (c < components.size()) && !worker.isStopped(); c = next++)
+            {
+              std::vector<node_t *> nodes;
+              nodes.reserve(components[c].size());
+              for (const node_t *node : components[c])
+              {
+                nodes.push_back(worker.Variables.find(node->indice()));
+              }
+              if (worker.solveComponents(nodes, 1U))
+              {
+                ++solved;
+              }
+              else
+              {
+                shared.Pool.stop();
+              }
+            }
+          });
+        }
+        for (std::thread &thread : pool)
+        {
+          thread.join();
+        }
+      }
+      bool sastified = (solved == components.size());
+      for (solver_t &worker : workers)
+      {
+        merge(worker);
+        AdditionalIndices.insert(AdditionalIndices.end(), worker.AdditionalIndices.begin(), worker.AdditionalIndices.end());
+        sastified = sastified && worker.AdditionalIndices.empty();
+      }
+      if (sastified)
+      {
+        for (const std::vector<node_t *> &component : components)
+        {
+          for (node_t *node : component)
+          {
+            for (const solver_t &worker : workers)
+            {
+              if (const node_t *found = worker.Variables.find(node->indice()); (found != nullptr) && found->isInstantiated())
+              {
+                static_cast<variable_t &>(*node) = *found;
+                break;
+              }
+            }
+          }
+        }
+      }
+      return sastified;
+    }
+
+    // Arrête la recherche de tous les fils d'exécution
+    void
+    stopAll()
+    {
+      if (Parallel != nullptr)
+      {
+        Parallel->Pool.stop();
+      }
+    }
+
+    // Oublie les résultats de l'instance, la mémoire des solutions est conservée pour les suivantes
+    void
+    forget()
+    {
+      for (solution_t &solution : SolutionList)
+      {
+        SpareSolutions.push_back(std::move(solution));
+      }
+      SolutionList.clear();
+      SolutionCount = 0U;
+      RejectedIndices.clear();
+      AdditionalIndices.clear();
+      Nogoods.clear();
+      Status = SearchStatus::Unknown;
+    }
+
+    void
+    endSearch()
+    {
+      // Le journal ne concerne que la recherche en cours
+      Trail.clear();
+      Path.clear();
+      Heap.clear();
+      clearQueue();
+      IsSolveInProgress = false;
+    }
+
+    // Recherche parallèle : chaque fil d'exécution dispose d'une copie du solveur.
+    // Une tâche est le chemin de décisions menant de la racine à un sous-arbre.
+    // Un point de choix peut céder sa branche alternative (var != val) aux fils inoccupés.
+    bool
+    parallelSolve(const bool all)
+    {
+      parallel_t shared(ThreadCount);
+      std::vector<solver_t> workers(ThreadCount, *this);
+      for (size_t w = 0U; w < workers.size(); ++w)
+      {
+        workers[w].ThreadCount = 1U;
+        workers[w].Parallel = &shared;
+        workers[w].WorkerId = w;
+        workers[w].SolutionList.clear();
+        workers[w].resetStatistics();
+        workers[w].SolutionCount = 0U;
+        workers[w].Random.seed(Seed + w);
+      }
+      shared.Pool.push(0U, path_t{});
+      {
+        std::vector<std::thread> threads;
+        threads.reserve(workers.size());
+        for (solver_t &worker : workers)
+        {
+          threads.emplace_back([&worker, all]()
+                               { worker.work(all); });
+        }
+        for (std::thread &thread : threads)
+        {
+          thread.join();
+        }
+      }
+      // Fusion des résultats
+      for (solver_t &worker : workers)
+      {
+        merge(worker);
+      }
+      if (all)
+      {
+        for (solver_t &worker : workers)
+        {
+          std::move(worker.SolutionList.begin(), worker.SolutionList.end(), std::back_inserter(SolutionList));
+        }
+      }
+      else if (shared.Winner < workers.size())
+      {
+        solver_t &winner = workers[shared.Winner];
+        SolutionList.push_back(std::move(winner.SolutionList.front()));
+        Variables = std::move(winner.Variables);
+      }
+      return !SolutionList.empty();
+    }
+
+    // Fusion des compteurs et des résultats d'un fil d'exécution
+    void
+    merge(const solver_t &worker)
+    {
+      ChoicePointCount += worker.ChoicePointCount;
+      BackupMemory += worker.BackupMemory;
+      PropagationCount += worker.PropagationCount;
+      FailureCount += worker.FailureCount;
+      BacktrackCount += worker.BacktrackCount;
+      ExclusionCount += worker.ExclusionCount;
+      FoundCount += worker.FoundCount;
+      PeakBackup.raise(worker.PeakBackup);
+      BackjumpCount += worker.BackjumpCount;
+      NogoodCount += worker.NogoodCount;
+      OutOfBudget = OutOfBudget || worker.OutOfBudget;
+      for (size_t p = 0U; p < Propagators.size(); ++p)
+      {
+        Propagators[p].Counters.Calls += worker.Propagators[p].Counters.Calls;
+        Propagators[p].Counters.Failures += worker.Propagators[p].Counters.Failures;
+        Propagators[p].Counters.Exclusions += worker.Propagators[p].Counters.Exclusions;
+        Propagators[p].Counters.Time += worker.Propagators[p].Counters.Time;
+      }
+      SolutionCount += worker.SolutionCount;
+      RejectedIndices.insert(worker.RejectedIndices.begin(), worker.RejectedIndices.end());
+    }
+
+    // Boucle d'un fil d'exécution : traite ses tâches puis vole celles des autres
+    void
+    work(const bool all)
+    {
+      const store_variable_t root = Variables;
+      bool idle = false;
+      while (!Parallel->Pool.stopped())
+      {
+        std::optional<path_t> job = Parallel->Pool.pop(WorkerId);
+        if (job.has_value())
+        {
+          if (idle)
+          {
+            Parallel->Pool.setIdle(false);
+            idle = false;
+          }
+          Variables = root;
+          IsSolveInProgress = true;
+          initSearch(Search);
+          if (replay(*job))
+          {
+            Path = std::move(*job);
+            searchSolutions(Search, all);
+          }
+          endSearch();
+          Parallel->Pool.done();
+        }
+        else if (Parallel->Pool.finished())
+        {
+          break;
+        }
+        else
+        {
+          if (!idle)
+          {
+            Parallel->Pool.setIdle(true);
+            idle = true;
+          }
+          std::this_thread::yield();
+        }
+      }
+    }
+
+    // Rejoue les décisions menant au sous-arbre d'une tâche
+    bool
+    replay(const path_t &path)
+    {
+      bool consistent = true;
+      for (auto it = path.begin(); (it != path.end()) && consistent; ++it)
+      {
+        node_t *node = Variables.find(it->Indice);
+        consistent = (node != nullptr);
+        if (consistent && it->Assign)
+        {
+          consistent = node->canBe(it->Value);
+          if (consistent && !node->isInstantiated())
+          {
+            assign(*node, it->Value);
+          }
+        }
+        else if (consistent)
+        {
+          consistent = !(node->isInstantiated() && node->canBe(it->Value));
+          if (consistent)
+          {
+            remove(*node, it->Value);
+          }
+        }
+      }
+      return consistent;
+    }
+
+    // Arrêt demandé par un autre fil ou budget épuisé
+    bool
+    isStopped()
+    {
+      if (!OutOfBudget && (NodeLimit != 0U) && (searchNodes() >= NodeLimit))
+      {
+        OutOfBudget = true;
+      }
+      if (!OutOfBudget && (TimeLimit != std::chrono::milliseconds::zero()) && (std::chrono::steady_clock::now() >= Deadline))
+      {
+        OutOfBudget = true;
+      }
+      if (OutOfBudget)
+      {
+        stopAll();
+      }
+      return OutOfBudget || ((Parallel != nullptr) && Parallel->Pool.stopped());
+    }
+
+    // Points de choix de la recherche en cours
+    size_t
+    searchNodes() const
+    {
+      return (Parallel != nullptr) ? Parallel->Nodes.load(std::memory_order_relaxed) : (ChoicePointCount - SearchStartNodes);
+    }
+
+    void
+    countNode()
+    {
+      if ((Parallel != nullptr) && (NodeLimit != 0U))
+      {
+        Parallel->Nodes.fetch_add(1U, std::memory_order_relaxed);
+      }
+    }
+
+    // Nombre d'échecs avant le prochain redémarrage
+    size_t
+    restartCutoff() const
+    {
+      if (Restarts == Restart::Luby)
+      {
+        return RestartScale * luby(RestartIndex + 1U);
+      }
+      return static_cast<size_t>(static_cast<double>(RestartScale) * std::pow(RestartFactor, static_cast<double>(RestartIndex)));
+    }
+
+    // Terme i (à partir de 1) de la suite de Luby
+    static size_t
+    luby(size_t i)
+    {
+      size_t k = 1U;
+      while (((size_t{1U} << k) - 1U) < i)
+      {
+        ++k;
+      }
+      while (i != ((size_t{1U} << k) - 1U))
+      {
+        i -= (size_t{1U} << (k - 1U)) - 1U;
+        k = 1U;
+        while (((size_t{1U} << k) - 1U) < i)
+        {
+          ++k;
+        }
+      }
+      return size_t{1U} << (k - 1U);
+    }
+
+    // Retour à la racine : le contexte du premier point de choix est restauré sans exclure sa valeur
+    void
+    restart(parameters_t &parameters)
+    {
+      if constexpr (StatisticsEnabled)
+      {
+        ++RestartCount;
+      }
+      ++RestartIndex;
+      RestartFailures = 0U;
+      RestartLimit = restartCutoff();
+      // Les propagateurs réveillés par la réfutation du retour arrière portent sur un état abandonné :
+      // une règle réveillée par une instanciation retirerait sa valeur aux voisines à la racine
+      clearQueue();
+      parameters.Backup.truncate(1U);
+      if (Mode == BacktrackMode::Copy)
+      {
+        restoreCopy(parameters, false);
+      }
+      else
+      {
+        restoreTrail(parameters, false);
+      }
+      if (Backjumping)
+      {
+        Variables.forEach([](node_t &node)
+        {
+          node.Reasons.clear();
+        });
+        ConflictValid = false;
+      }
+      HeapDirty = true;
+      ImpactIndice = std::nullopt;
+    }
+
+    bool 
+    SearchSolution(parameters_t& parameters)
+    {
+      bool isSolution = false;
+      bool sastified = true;
+      // TANT QUE (la solution n'est pas trouvé et que toutes les contraintes sont sastifaites) FAIRE 
+      //   réduire le nombre de variable constituant le problème et vérifier la cohérence du problème
+      //   si une solution partielle est trouvée, déterminer un point de choix
       //   sinon si une solution est trouvée, arrêter
       //   sinon si un point de choix existe, revenir en arrière (les contraintes du problèmes ne sont pas sastifaites)
       //   sinon arrêter (les contraintes du problèmes ne sont pas sastifaites)
-      while (!isSolution && sastified)
+      while (!isSolution && sastified && !isStopped())
+      {
+        bool isPartialSolution = true;
+        if (!parameters.Processing.empty())
+        {
+          // Réduit le problème en appliquant les contraintes
+          std::tie(sastified, isPartialSolution) = partitionAndConstrain(parameters);
+
+          // Fait un choix
+          if (isPartialSolution)
+          {
+            // Mémorise le contexte et le choix pour le backtracking
+            selectVariableAndValue(parameters);
+          }
+        }
+        else 
+        {
+          // Aucune variable 
+          sastified = false;
+        }
+        isSolution = sastified && !isPartialSolution;
+
+        // Mauvais choix ou recherche d'une autre solution, réinitialise les variables
+        if ((!sastified) && (!parameters.Backup.empty()))
+        {
+          sastified = backtracking(parameters);
+          if (sastified && RestartsActive && (++RestartFailures >= RestartLimit) && !parameters.Backup.empty())
+          {
+            restart(parameters);
+          }
+        }
+      }
+      return isSolution;
+    }
+
+    std::tuple<bool,bool>
+    partitionAndConstrain(parameters_t& parameters)
+    {
+      // TANT QUE (la file de propagation n'est pas vide) FAIRE 
+      //   intégrer les nouvelles variables créées pendant la recherche
+      //   réveiller le propagateur en tête de file pour la variable qui l'a déclenché
+      //   (les exclusions réalisées placent dans la file les propagateurs concernés)
+      // Partitionner les variables instanciées parmi les variables du problème
+      //   appliquer les nogoods, les exclusions déduites relancent la propagation
+      bool sastified = true;
+      bool hasNoInstantiatedVars = false;
+      ConflictValid = false;
+      attachAdditional(parameters);
+      bool propagating = true;
+      while (propagating)
+      {
+        while (sastified && (QueueHead < Queue.size()))
+        {
+          const event_item_t item = Queue[QueueHead];
+          ++QueueHead;
+          propagator_t &propagator = Propagators[item.Propagator];
+          propagator.Queued = false;
+          ++PropagationCount;
+          sastified = profile(item);
+          if (!sastified)
+          {
+            penalize(item.Propagator);
+          }
+          attachAdditional(parameters);
+        }
+        propagating = sastified && !Nogoods.empty();
+        if (propagating)
+        {
+          sastified = applyNogoods();
+          propagating = sastified && (QueueHead < Queue.size());
+        }
+      }
+      clearQueue();
+      if (sastified)
+      {
+        auto &&it = std::partition(parameters.Processing.begin(), parameters.Processing.end(),
+                                   [](const variable_t &var)
+                                   { return !var.isInstantiated(); });
+        if (Mode == BacktrackMode::Trail)
+        {
+          // Les variables sorties du traitement seront réintégrées lors du retour arrière
+          parameters.Detached.insert(parameters.Detached.end(), it, parameters.Processing.end());
+        }
+        parameters.Processing.erase(it, parameters.Processing.end());
+        hasNoInstantiatedVars = (!parameters.Processing.empty());
+      }
+      measureImpact(parameters, sastified);
+      return std::make_tuple(sastified, sastified && hasNoInstantiatedVars);
+    }
+
+    // Appel d'un propagateur avec mise à jour de ses compteurs
+    bool
+    profile(const event_item_t &item)
+    {
+      bool sastified = true;
+      CurrentPropagator = item.Propagator;
+      if (Backjumping)
+      {
+        explain(item);
+      }
+      if constexpr (ProfilingEnabled)
+      {
+        const auto start = std::chrono::steady_clock::now();
+        sastified = propagate(item.Propagator, item.Node->indice(), item.Node->value());
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        Propagators[item.Propagator].Counters.Time += static_cast<size_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+      }
+      else
+      {
+        sastified = propagate(item.Propagator, item.Node->indice(), item.Node->value());
+      }
+      CurrentPropagator = NoPropagator;
+      Explaining = false;
+      if (Backjumping && !sastified && !ConflictValid)
+      {
+        // Echec constaté par le propagateur lui-même
+        Conflict = Explanation;
+        ConflictValid = true;
+      }
+      if constexpr (StatisticsEnabled)
+      {
+        constraint_counters_t &counters = Propagators[item.Propagator].Counters;
+        ++counters.Calls;
+        if (!sastified)
+        {
+          ++counters.Failures;
+          ++FailureCount;
+        }
+      }
+      return sastified;
+    }
+
+    bool
+    propagate(const size_t p, const indice_t indice, const value_t value)
+    {
+      if constexpr (StaticConstraintCount > 0U)
+      {
+        if (p == 0U)
+        {
+          return propagateStatic(indice, value, std::make_index_sequence<StaticConstraintCount>{});
+        }
+      }
+      return Propagators[p].Fct(*this, indice, value);
+    }
+
+    // Appel direct et successif des contraintes du paquet statique
+    template <size_t... I>
+    bool
+    propagateStatic(const indice_t indice, const value_t value, std::index_sequence<I...>)
+    {
+      return (std::get<I>(Pack.Fcts)(*this, indice, value) && ...);
+    }
+
+    // Ajout des nouvelles variables créées pendant la recherche
+    void
+    attachAdditional(parameters_t& parameters)
+    {
+      for (const indice_t &newIndice : AdditionalIndices)
+      {
+        if (node_t *var = Variables.find(newIndice); var != nullptr)
+        {
+          parameters.Processing.push_back(*var);
+          parameters.Register.push_back(newIndice);
+          reorder(*var);
+          if (var->isInstantiated())
+          {
+            notify(*var, Event::Instantiated | Event::BoundsChanged | Event::DomainChanged);
+          }
+        }
+      }
+      AdditionalIndices.clear();
+    }
+
+    void
+    selectVariableAndValue(parameters_t& parameters)
+    {
+      // Sélection de la variable selon l'heuristique
+      variable_t& var = selectVariable(parameters);
+      if (Order == Heuristic::Impact)
+      {
+        ImpactIndice = var.indice();
+        ImpactSpace = searchSpace(parameters);
+      }
+      // Sélectionne la valeur
+      value_t val = var.value();
+      if (Selector)
+      {
+        val = Selector(var);
+      }
+      else if (Randomize)
+      {
+        val = *std::next(var.domain().begin(), static_cast<std::ptrdiff_t>(Random() % var.domainSize()));
+      }
+      if ((Parallel != nullptr) && Parallel->Pool.hungry())
+      {
+        // Cède la branche alternative (var != val) à un fil d'exécution inoccupé
+        path_t job = Path;
+        job.push_back(decision_t{var.indice(), val, false});
+        Parallel->Pool.push(WorkerId, std::move(job));
+        Path.push_back(decision_t{var.indice(), val, true});
+        ++ChoicePointCount;
+        countNode();
+        if (Backjumping && !parameters.Backup.empty())
+        {
+          // Sans point de choix propre, la décision est défaite avec le dernier point de choix
+          static_cast<node_t &>(var).Reasons.insert(parameters.Backup.size());
+        }
+        assign(var, val);
+        return;
+      }
+      // Enregistrement réutilisé : ses tampons conservent leur capacité d'un point de choix à l'autre
+      record_t &save = parameters.Backup.push([]()
+                                              { return record_t{}; });
+      save.RegisterSize = parameters.Register.size();
+      save.TrailSize = Trail.size();
+      save.DetachedSize = parameters.Detached.size();
+      save.PathSize = Path.size();
+      save.ChoiceIndice = var.indice();
+      save.ChoiceValue = val;
+      BackupMemory += sizeof(record_t);
+      save.Register.clear();
+      save.RemainingVariables.clear();
+      if (Mode == BacktrackMode::Copy)
+      {
+        // Copie du contexte
+        save.Register = parameters.Register;
+        save.RemainingVariables.assign(parameters.Processing.begin(), parameters.Processing.end());
+        BackupMemory += save.Register.size() * sizeof(indice_t);
+        for (const variable_t &remaining : save.RemainingVariables)
+        {
+          BackupMemory += sizeof(variable_t) + footprint(remaining.domain());
+        }
+      }
+      if (Parallel != nullptr)
+      {
+        Path.push_back(decision_t{var.indice(), val, true});
+      }
+      ++ChoicePointCount;
+      countNode();
+      //std::cout << "try (" << copyIndice.X << ", " << copyIndice.Y << ") = " << copyVal << std::endl;
+      if constexpr (StatisticsEnabled)
+      {
+        PeakBackup.raise(parameters.Backup.size());
+      }
+      if (Backjumping)
+      {
+        // Le niveau du choix est sa profondeur dans la pile des points de choix
+        static_cast<node_t &>(var).Reasons.insert(parameters.Backup.size());
+      }
+      // Définit le choix de la valeur
+      assign(var, val);
+    }
+
+    // Retourne false si aucun point de choix ne peut résoudre le conflit (recherche terminée)
+    bool
+    backtracking(parameters_t& parameters)
+    {
+      if constexpr (StatisticsEnabled)
+      {
+        ++BacktrackCount;
+      }
+      LevelSet reason;
+      if (Backjumping)
+      {
+        size_t level = parameters.Backup.size();
+        if (ConflictValid)
+        {
+          // Retour au dernier point de choix impliqué dans le conflit
+          learn(parameters);
+          level = std::min(Conflict.max(), level);
+          if constexpr (StatisticsEnabled)
+          {
+            BackjumpCount += parameters.Backup.size() - level;
+          }
+          if (level == 0U)
+          {
+            parameters.Backup.clear();
+            return false;
+          }
+          parameters.Backup.truncate(level);
+          reason = Conflict;
+        }
+        else
+        {
+          // Retour arrière chronologique (après une solution) : la réfutation dépend de tous les choix précédents
+          reason.fill(level);
+        }
+        reason.truncate(level);
+        Variables.forEach([level](node_t &node)
+        {
+          node.Reasons.truncate(level);
+        });
+        ConflictValid = false;
+      }
+      const indice_t choice = parameters.Backup.back().ChoiceIndice;
+      if (Parallel != nullptr)
+      {
+        // Le chemin reprend au point de choix avec la valeur écartée
+        const record_t &save = parameters.Backup.back();
+        Path.erase(Path.begin() + save.PathSize, Path.end());
+        Path.push_back(decision_t{save.ChoiceIndice, save.ChoiceValue, false});
+      }
+      if (Mode == BacktrackMode::Copy)
+      {
+        restoreCopy(parameters, true);
+      }
+      else
+      {
+        restoreTrail(parameters, true);
+      }
+      if (Backjumping)
+      {
+        if (node_t *var = Variables.find(choice); var != nullptr)
+        {
+          var->Reasons.merge(reason);
+        }
+      }
+      return true;
+    }
+
+    // refute : exclut la valeur du point de choix restauré
+    void 
+    restoreCopy(parameters_t& parameters, const bool refute)
+    {
+      // L'enregistrement dépilé reste en réserve dans la pile, il demeure valide jusqu'au prochain point de choix
+      const record_t &save = parameters.Backup.back();
+      parameters.Backup.pop_back();
+      // Copier les variables non viables
+      auto &&it = parameters.Register.begin();    
+      std::advance(it, save.Register.size());
+      for (; it != parameters.Register.end(); ++it)
+      {
+        RejectedIndices.insert(*it);
+        Variables.erase(*it);
+      }
+      for (it = AdditionalIndices.begin(); it != AdditionalIndices.end(); ++it)
+      {
+        RejectedIndices.insert(*it);
+        Variables.erase(*it);
+      }
+      // Restaure les variables
+      parameters.Processing.clear();
+      parameters.Processing.reserve(save.RemainingVariables.size());
+      for (auto&& var : save.RemainingVariables)
+      {
+        if (node_t *found = Variables.find(var.indice()); found != nullptr)
+        {
+          static_cast<variable_t &>(*found) = var;
+          parameters.Processing.push_back(*found);
+        }
+      }
+      parameters.Register = save.Register;
+      AdditionalIndices.clear();
+      HeapDirty = true;
+      // Elimine la valeur déjà analysée de la variable
+      if (node_t *var = Variables.find(save.ChoiceIndice); refute && (var != nullptr))
+      {
+        remove(*var, save.ChoiceValue);
+      }
+      //std::cout << "backtracking (" << indice.X << ", " << indice.Y << ") = " << val << std::endl;
+    }
+
+    void 
+    restoreTrail(parameters_t& parameters, const bool refute)
+    {
+      const record_t &save = parameters.Backup.back();
+      parameters.Backup.pop_back();
+      // Annule les exclusions réalisées depuis le point de choix
+      while (Trail.size() > save.TrailSize)
+      {
+        const trail_entry_t& entry = Trail.back();
+        entry.Variable->restore(entry.Value);
+        touch(static_cast<node_t &>(*entry.Variable));
+        Trail.pop_back();
+      }
+      for (node_t *node : TouchedNodes)
+      {
+        node->Touched = false;
+        reorder(*node);
+      }
+      TouchedNodes.clear();
+      // Réintègre les variables sorties du traitement depuis le point de choix
+      parameters.Processing.insert(parameters.Processing.end(), 
+                                   parameters.Detached.begin() + save.DetachedSize, 
+                                   parameters.Detached.end());
+      parameters.Detached.erase(parameters.Detached.begin() + save.DetachedSize, parameters.Detached.end());
+      // Supprime les variables non viables créées depuis le point de choix
+      set_indice_t rejected(parameters.Register.begin() + save.RegisterSize, parameters.Register.end());
+      rejected.insert(AdditionalIndices.begin(), AdditionalIndices.end());
+      if (!rejected.empty())
+      {
+        std::erase_if(parameters.Processing, [&rejected](const variable_t &var)
+                      { return rejected.contains(var.indice()); });
+        for (const indice_t &indice : rejected)
+        {
+          RejectedIndices.insert(indice);
+          Variables.erase(indice);
+        }
+      }
+      parameters.Register.resize(save.RegisterSize);
+      AdditionalIndices.clear();
+      // Elimine la valeur déjà analysée de la variable
+      if (node_t *var = Variables.find(save.ChoiceIndice); refute && (var != nullptr))
+      {
+        remove(*var, save.ChoiceValue);
+      }
+    }
+
+    // Exclut une valeur du domaine, la journalise en mode Trail et réveille les propagateurs concernés
+    void
+    remove(node_t &var, const value_t value)
+    {
+      if (var.canBe(value))
+      {
+        Event changes = Event::DomainChanged;
+        if ((value == var.domain().min()) || (value == var.domain().max()))
+        {
+          changes = changes | Event::BoundsChanged;
+        }
+        if (Mode == BacktrackMode::Trail)
+        {
+          log(var, value);
+        }
+        if constexpr (StatisticsEnabled)
+        {
+          ++ExclusionCount;
+          if (CurrentPropagator != NoPropagator)
+          {
+            ++Propagators[CurrentPropagator].Counters.Exclusions;
+          }
+        }
+        if (Explaining)
+        {
+          var.Reasons.merge(Explanation);
+        }
+        var.exclude(value);
+        if (var.isInstantiated())
+        {
+          changes = changes | Event::Instantiated;
+        }
+        reorder(var);
+        notify(var, changes);
+      }
+    }
+
+    // Explication des exclusions d'un propagateur : niveaux de la variable reçue pour une contrainte globale,
+    // de l'ensemble des variables surveillées sinon
+    void
+    explain(const event_item_t &item)
+    {
+      const propagator_t &propagator = Propagators[item.Propagator];
+      Explanation = item.Node->Reasons;
+      for (const indice_t &indice : propagator.Watched)
+      {
+        if (const node_t *node = Variables.find(indice); node != nullptr)
+        {
+          Explanation.merge(node->Reasons);
+        }
+      }
+      Explaining = true;
+    }
+
+    // Mémorise les choix impliqués dans le conflit
+    void
+    learn(const parameters_t &parameters)
+    {
+      if ((NogoodCapacity == 0U) || Conflict.empty() || (Conflict.size() > NogoodMaxLength))
+      {
+        return;
+      }
+      nogood_t nogood;
+      size_t level = 0U;
+      for (auto it = parameters.Backup.begin(); it != parameters.Backup.end(); ++it)
+      {
+        ++level;
+        if (!Conflict.contains(level))
+        {
+          continue;
+        }
+        if (Parallel == nullptr)
+        {
+          nogood.push_back(literal_t{it->ChoiceIndice, it->ChoiceValue});
+        }
+        else
+        {
+          // Le niveau couvre aussi les affectations dont la branche alternative a été cédée à un autre fil
+          const auto next = std::next(it);
+          const size_t last = (next != parameters.Backup.end()) ? next->PathSize : Path.size();
+          for (size_t d = it->PathSize; d < last; ++d)
+          {
+            if (Path[d].Assign)
+            {
+              nogood.push_back(literal_t{Path[d].Indice, Path[d].Value});
+            }
+          }
+        }
+      }
+      if (nogood.size() > NogoodMaxLength)
+      {
+        return;
+      }
+      if (Nogoods.size() >= NogoodCapacity)
+      {
+        Nogoods.pop_front();
+      }
+      Nogoods.push_back(std::move(nogood));
+      if constexpr (StatisticsEnabled)
+      {
+        ++NogoodCount;
+      }
+    }
+
+    // Un nogood dont toutes les affectations sont réalisées est un échec,
+    // un nogood dont il ne manque qu'une affectation interdit celle-ci
+    bool
+    applyNogoods()
+    {
+      for (const nogood_t &nogood : Nogoods)
+      {
+        node_t *open = nullptr;
+        value_t openValue{};
+        bool active = true;
+        Explanation.clear();
+        for (auto it = nogood.begin(); (it != nogood.end()) && active; ++it)
+        {
+          node_t *node = Variables.find(it->Indice);
+          active = (node != nullptr) && node->canBe(it->Value);
+          if (active && node->isInstantiated())
+          {
+            Explanation.merge(node->Reasons);
+          }
+          else if (active)
+          {
+            active = (open == nullptr);
+            open = node;
+            openValue = it->Value;
+          }
+        }
+        if (active && (open == nullptr))
+        {
+          Conflict = Explanation;
+          ConflictValid = true;
+          return false;
+        }
+        if (active)
+        {
+          Explaining = true;
+          remove(*open, openValue);
+          Explaining = false;
+        }
+      }
+      return true;
+    }
+
+    // Instancie une variable, journalise les valeurs écartées en mode Trail et réveille les propagateurs concernés
+    void
+    assign(variable_t &var, const value_t value)
+    {
+      if (Mode == BacktrackMode::Trail)
+      {
+        for (const value_t other : var.domain())
+        {
+          if (other != value)
+          {
+            log(var, other);
+          }
+        }
+      }
+      var.set(value);
+      notify(static_cast<node_t &>(var), Event::Instantiated | Event::BoundsChanged | Event::DomainChanged);
+    }
+
+    variable_t &
+    selectVariable(parameters_t &parameters)
+    {
+      if (Order == Heuristic::Comparator)
+      {
+        if (Randomize)
+        {
+          return randomMinimum(parameters);
+        }
+        // Seule la plus petite variable est nécessaire : recherche linéaire sans tri
+        return *std::min_element(parameters.Processing.begin(), parameters.Processing.end(),
+                                 [this](const variable_t &var1, const variable_t &var2) { return precedes(var1, var2); });
+      }
+      if (HeapDirty || (Heap.size() > 4U * parameters.Processing.size() + 16U))
+      {
+        rebuildHeap(parameters);
+      }
+      node_t *selected = popHeap();
+      if (selected == nullptr)
+      {
+        rebuildHeap(parameters);
+        selected = popHeap();
+      }
+      return (selected != nullptr) ? *selected : parameters.Processing.front().get();
+    }
+
+    // Ordre du choix de variable : le comparateur, puis le plus petit indice à égalité. Le choix ne dépend pas de l'ordre
+    // de la liste de traitement, qui diffère d'un mode de retour arrière à l'autre (le journal réintègre les variables
+    // détachées en fin de liste) : les modes Copy et Trail parcourent le même arbre.
+    bool
+    precedes(const variable_t &var1, const variable_t &var2) const
+    {
+      if (Comparator)
+      {
+        if (Comparator(var1, var2))
+        {
+          return true;
+        }
+        if (Comparator(var2, var1))
+        {
+          return false;
+        }
+      }
+      return var1.indice() < var2.indice();
+    }
+
+    // Tirage uniforme parmi les plus petites variables selon le comparateur (toutes les variables à défaut)
+    variable_t &
+    randomMinimum(parameters_t &parameters)
+    {
+      size_t selected = 0U;
+      size_t ties = 1U;
+      for (size_t v = 1U; v < parameters.Processing.size(); ++v)
+      {
+        const variable_t &candidate = parameters.Processing[v];
+        const variable_t &best = parameters.Processing[selected];
+        if (Comparator && Comparator(candidate, best))
+        {
+          selected = v;
+          ties = 1U;
+        }
+        else if (!Comparator || !Comparator(best, candidate))
+        {
+          ++ties;
+          if ((Random() % ties) == 0U)
+          {
+            selected = v;
+          }
+        }
+      }
+      return parameters.Processing[selected];
+    }
+
+    // Extrait la variable de plus petite clé, les entrées périmées sont ignorées
+    node_t *
+    popHeap()
+    {
+      node_t *selected = nullptr;
+      while ((selected == nullptr) && !Heap.empty())
+      {
+        std::pop_heap(Heap.begin(), Heap.end(), heapGreater);
+        const heap_entry_t entry = Heap.back();
+        Heap.pop_back();
+        node_t *node = Variables.find(entry.Indice);
+        if ((node != nullptr) && (node->Stamp == entry.Stamp) && !node->isInstantiated())
+        {
+          selected = node;
+        }
+      }
+      return selected;
+    }
+
+    void
+    rebuildHeap(parameters_t &parameters)
+    {
+      Heap.clear();
+      HeapDirty = false;
+      if (Order != Heuristic::Comparator)
+      {
+        for (variable_t &var : parameters.Processing)
+        {
+          node_t &node = static_cast<node_t &>(var);
+          ++node.Stamp;
+          Heap.push_back(heap_entry_t{score(node), tie(), node.Stamp, node.indice()});
+        }
+        std::make_heap(Heap.begin(), Heap.end(), heapGreater);
+      }
+    }
+
+    // Met à jour la clé d'une variable dont le domaine ou le poids a changé
+    void
+    reorder(node_t &node)
+    {
+      if ((Order != Heuristic::Comparator) && IsSolveInProgress && !node.isInstantiated())
+      {
+        ++node.Stamp;
+        Heap.push_back(heap_entry_t{score(node), tie(), node.Stamp, node.indice()});
+        std::push_heap(Heap.begin(), Heap.end(), heapGreater);
+      }
+    }
+
+    // Mémorise une variable restaurée lors du retour arrière (une seule mise à jour par variable)
+    void
+    touch(node_t &node)
+    {
+      if ((Order != Heuristic::Comparator) && !node.Touched)
+      {
+        node.Touched = true;
+        TouchedNodes.push_back(&node);
+      }
+    }
+
+    static bool
+    heapGreater(const heap_entry_t &lhs, const heap_entry_t &rhs)
+    {
+      if (lhs.Key != rhs.Key)
+      {
+        return lhs.Key > rhs.Key;
+      }
+      if (lhs.Tie != rhs.Tie)
+      {
+        return lhs.Tie > rhs.Tie;
+      }
+      return rhs.Indice < lhs.Indice;
+    }
+
+    std::uint64_t
+    tie()
+    {
+      return Randomize ? Random() : 0U;
+    }
+
+    double
+    score(const node_t &node) const
+    {
+      const double size = static_cast<double>(node.domainSize());
+      double key = size;
+      if (Order == Heuristic::DomDeg)
+      {
+        key = size / static_cast<double>(std::max<size_t>(node.Watchers.size() + GlobalWatchers.size(), 1U));
+      }
+      else if (Order == Heuristic::DomWdeg)
+      {
+        size_t weight = GlobalWeight;
+        for (const watch_t &watcher : node.Watchers)
+        {
+          weight += Propagators[watcher.Propagator].Weight;
+        }
+        key = size / static_cast<double>(std::max<size_t>(weight, 1U));
+      }
+      else if (Order == Heuristic::Impact)
+      {
+        const double impact = (node.ImpactCount == 0U) ? 0.0 : (node.ImpactSum / static_cast<double>(node.ImpactCount));
+        key = size * (1.0 - impact);
+      }
+      return key;
+    }
+
+    // Un échec augmente le poids de la contrainte et donc la priorité des variables qu'elle surveille
+    void
+    penalize(const size_t p)
+    {
+      propagator_t &propagator = Propagators[p];
+      ++propagator.Weight;
+      if (Order == Heuristic::DomWdeg)
+      {
+        if (propagator.Watched.empty())
+        {
+          // Contrainte globale : toutes les clés changent
+          ++GlobalWeight;
+          HeapDirty = true;
+        }
+        else
+        {
+          for (const indice_t &indice : propagator.Watched)
+          {
+            if (node_t *node = Variables.find(indice); node != nullptr)
+            {
+              reorder(*node);
+            }
+          }
+        }
+      }
+      else if (propagator.Watched.empty())
+      {
+        ++GlobalWeight;
+      }
+    }
+
+    // Logarithme de la taille de l'espace de recherche restant
+    static double
+    searchSpace(const parameters_t &parameters)
+    {
+      double space = 0.0;
+      for (const variable_t &var : parameters.Processing)
+      {
+        space += std::log2(static_cast<double>(var.domainSize()));
+      }
+      return space;
+    }
+
+    // Impact du dernier choix : 1 - (espace après propagation / espace avant), 1 en cas d'échec
+    void
+    measureImpact(const parameters_t &parameters, const bool sastified)
+    {
+      if (ImpactIndice.has_value())
+      {
+        if (node_t *node = Variables.find(*ImpactIndice); node != nullptr)
+        {
+          const double impact = sastified ? (1.0 - std::exp2(searchSpace(parameters) - ImpactSpace)) : 1.0;
+          node->ImpactSum += std::clamp(impact, 0.0, 1.0);
+          ++node->ImpactCount;
+        }
+        ImpactIndice = std::nullopt;
+      }
+    }
+
+    // Abonne les propagateurs aux variables surveillées
+    void
+    watchAll()
+    {
+      Variables.forEach([](node_t &node)
+      {
+        node.Watchers.clear();
+      });
+      for (size_t p = 0U; p < Propagators.size(); ++p)
+      {
+        Propagators[p].Queued = false;
+        for (const indice_t &indice : Propagators[p].Watched)
+        {
+          if (node_t *node = Variables.find(indice); node != nullptr)
+          {
+            node->Watchers.push_back(watch_t{p, Propagators[p].Events});
+          }
+        }
+      }
+    }
+
+    // Abonne les propagateurs à une variable créée pendant la recherche
+    void
+    watch(node_t &node)
+    {
+      node.Watchers.clear();
+      for (size_t p = 0U; p < Propagators.size(); ++p)
+      {
+        if (std::find(Propagators[p].Watched.begin(), Propagators[p].Watched.end(), node.indice()) != Propagators[p].Watched.end())
+        {
+          node.Watchers.push_back(watch_t{p, Propagators[p].Events});
+        }
+      }
+    }
+
+    // Place dans la file les propagateurs abonnés aux modifications d'une variable
+    void
+    notify(node_t &node, const Event changes)
+    {
+      if (IsSolveInProgress)
+      {
+        if (intersects(changes, Event::Instantiated))
+        {
+          for (const size_t p : GlobalWatchers)
+          {
+            Queue.push_back(event_item_t{p, &node});
+          }
+        }
+        for (const watch_t &watcher : node.Watchers)
+        {
+          if (intersects(watcher.Events, changes))
+          {
+            schedule(watcher.Propagator, node);
+          }
+        }
+      }
+    }
+
+    void
+    schedule(const size_t p, node_t &node)
+    {
+      propagator_t &propagator = Propagators[p];
+      if (propagator.Events == Event::Instantiated)
       {
-        bool isPartialSolution = true;
-        if (!parameters.Processing.empty())
+        Queue.push_back(event_item_t{p, &node});
+      }
+      else if (!propagator.Queued)
+      {
+        propagator.Queued = true;
+        Queue.push_back(event_item_t{p, &node});
+      }
+    }
+
+    void
+    clearQueue()
+    {
+      for (; QueueHead < Queue.size(); ++QueueHead)
+      {
+        Propagators[Queue[QueueHead].Propagator].Queued = false;
+      }
+      Queue.clear();
+      QueueHead = 0U;
+    }
+
+    void
+    log(variable_t &var, const value_t value)
+    {
+      Trail.push_back(trail_entry_t{&var, value});
+      BackupMemory += sizeof(trail_entry_t);
+    }
+
+    static size_t
+    footprint(const domain_t &domain)
+    {
+      if constexpr (requires { domain.footprint(); })
+      {
+        return domain.footprint();
+      }
+      else
+      {
+        return domain.size() * sizeof(value_t);
+      }
+    }
+
+    bool IsSolveInProgress;
+    BacktrackMode Mode;
+    Counter ChoicePointCount;
+    size_t BackupMemory;
+    trail_t Trail;
+    comparator_t Comparator;
+    selector_t Selector;
+    PackT Pack;
+    std::vector<propagator_t> Propagators;
+    std::vector<size_t> GlobalWatchers;
+    std::vector<event_item_t> Queue;
+    size_t QueueHead;
+    Counter PropagationCount;
+    Counter FailureCount;
+    Counter BacktrackCount;
+    Counter ExclusionCount;
+    Counter FoundCount;
+    Counter PeakBackup;
+    // Propagateur en cours d'exécution (NoPropagator hors propagation)
+    size_t CurrentPropagator;
+    size_t ThreadCount;
+    parallel_t* Parallel;
+    size_t WorkerId;
+    path_t Path;
+    store_variable_t Variables;
+    // Etat des variables au début de la dernière recherche (reload, setReloadable)
+    store_variable_t Initial;
+    bool HasInitial;
+    bool Reloadable;
+    // Données de la recherche, réutilisées d'une recherche à l'autre
+    parameters_t Search;
+    list_indice_t AdditionalIndices;
+    set_indice_t RejectedIndices;
+    solution_list_t SolutionList;
+    solution_list_t SpareSolutions;
+    CollectMode Collect;
+    visitor_t Visitor;
+    size_t SolutionLimit;
+    size_t SolutionCount;
+    typename solution_view_t::pointer_list_t ViewBuffer;
+    Heuristic Order;
+    std::vector<heap_entry_t> Heap;
+    bool HeapDirty;
+    std::vector<node_t *> TouchedNodes;
+    size_t GlobalWeight;
+    std::optional<indice_t> ImpactIndice;
+    double ImpactSpace;
+    bool Backjumping;
+    size_t NogoodCapacity;
+    std::deque<nogood_t> Nogoods;
+    // Explication du propagateur ou du nogood en cours (Explaining) et du dernier échec (ConflictValid)
+    LevelSet Explanation;
+    bool Explaining;
+    LevelSet Conflict;
+    bool ConflictValid;
+    Counter BackjumpCount;
+    Counter NogoodCount;
+    Restart Restarts;
+    size_t RestartScale;
+    double RestartFactor;
+    // Redémarrages de la recherche en cours : rang dans la suite, échecs depuis le dernier redémarrage et seuil
+    bool RestartsActive;
+    size_t RestartIndex;
+    size_t RestartFailures;
+    size_t RestartLimit;
+    Counter RestartCount;
+    bool Randomize;
+    std::uint64_t Seed;
+    std::mt19937_64 Random;
+    size_t NodeLimit;
+    std::chrono::milliseconds TimeLimit;
+    std::chrono::steady_clock::time_point Deadline;
+    size_t SearchStartNodes;
+    bool OutOfBudget;
+    SearchStatus Status;
+    neighbourhood_t Neighbourhood;
+    std::vector<indice_t> NeighbourBuffer;
+    std::map<count_key_t, size_t> CountCache;
+    bool Decomposition;
+  };
+
+  // Niveau de filtrage de la contrainte AllDifferent :
+  // - Bounds : cohérence de bornes par intervalles de Hall (un ensemble de k variables dont les bornes tiennent dans
+  //   un intervalle de k valeurs réserve ces valeurs, les bornes des autres variables en sortent)
+  // - Domain : cohérence de domaine par couplage maximum et composantes fortement connexes (algorithme de Régin)
+  enum class Consistency
+  {
+    Bounds,
+    Domain
+  };
+
+  // Contrainte globale : les variables désignées prennent toutes des valeurs différentes.
+  // Le propagateur conserve son couplage entre deux appels, le couplage précédent sert de point de départ
+  // et seules les variables dont la valeur couplée a été retirée sont réaffectées.
+  template <class SolverT>
+    requires std::is_integral_v<typename SolverT::value_t>
+  class AllDifferent
+  {
+  public:
+    using indice_t = typename SolverT::indice_t;
+    using value_t = typename SolverT::value_t;
+
+    explicit AllDifferent(std::vector<indice_t> indices, const Consistency consistency = Consistency::Bounds)
+        : Indices(std::move(indices)), Level(consistency), Matched(Indices.size())
+    {
+    }
+
+    // Evénements à surveiller pour le niveau de filtrage
+    Event events() const
+    {
+      return (Level == Consistency::Domain) ? Event::DomainChanged : Event::BoundsChanged;
+    }
+
+    const std::vector<indice_t> &indices() const
+    {
+      return Indices;
+    }
+
+    bool operator()(SolverT &solver, const indice_t, const value_t)
+    {
+      return (Level == Consistency::Domain) ? filterDomain(solver) : filterBounds(solver);
+    }
+
+  private:
+    static constexpr size_t Free = static_cast<size_t>(-1);
+
+    // Bornes d'une variable et rangs de Min et de Max + 1 parmi les bornes distinctes de toutes les variables
+    using bound_t = std::int64_t;
+    struct bounds_t
+    {
+      bound_t Min;
+      bound_t Max;
+      size_t MinRank;
+      size_t MaxRank;
+      size_t Variable;
+    };
+
+    // Cohérence de bornes en O(n log n) (López-Ortiz, Quimper, Tromp et van Beek) : après le tri des bornes,
+    // un balayage par Max croissant relève les bornes inférieures et un balayage par Min décroissant abaisse
+    // les bornes supérieures ; capacités des intervalles et intervalles de Hall sont suivis par des arbres
+    // d'union-recherche à compression de chemin.
+    bool filterBounds(SolverT &solver)
+    {
+      Bounds.clear();
+      Variables.assign(Indices.size(), nullptr);
+      for (size_t i = 0U; i < Indices.size(); ++i)
+      {
+        Variables[i] = solver.find(Indices[i]);
+        if (Variables[i] != nullptr)
         {
-          // Réduit le problème en appliquant les contraintes
-          std::tie(sastified, isPartialSolution) = partitionAndConstrain(parameters);
+          Bounds.push_back(bounds_t{static_cast<bound_t>(Variables[i]->domain().min()),
+                                    static_cast<bound_t>(Variables[i]->domain().max()), 0U, 0U, i});
+        }
+      }
+      if (Bounds.empty())
+      {
+        return true;
+      }
+      rank();
+      bool sastified = raiseLower() && lowerUpper();
+      for (size_t k = 0U; (k < Bounds.size()) && sastified; ++k)
+      {
+        const bounds_t &bounds = Bounds[k];
+        const auto *var = Variables[bounds.Variable];
+        const bound_t min = static_cast<bound_t>(var->domain().min());
+        const bound_t max = static_cast<bound_t>(var->domain().max());
+        for (bound_t value = min; (value < bounds.Min) && (value <= max) && sastified; ++value)
+        {
+          if (var->canBe(static_cast<value_t>(value)))
+          {
+            sastified = solver.exclude(static_cast<value_t>(value), Indices[bounds.Variable]);
+          }
+        }
+        for (bound_t value = max; (value > bounds.Max) && (value >= min) && sastified; --value)
+        {
+          if (var->canBe(static_cast<value_t>(value)))
+          {
+            sastified = solver.exclude(static_cast<value_t>(value), Indices[bounds.Variable]);
+          }
+        }
+      }
+      return sastified;
+    }
 
-          // Fait un choix
-          if (isPartialSolution)
+    // Bornes distinctes (Min et Max + 1) triées dans Limits, encadrées de deux sentinelles, et rangs de chaque variable
+    void rank()
+    {
+      const size_t n = Bounds.size();
+      MinSorted.resize(n);
+      MaxSorted.resize(n);
+      std::iota(MinSorted.begin(), MinSorted.end(), 0U);
+      std::iota(MaxSorted.begin(), MaxSorted.end(), 0U);
+      std::sort(MinSorted.begin(), MinSorted.end(), [this](const size_t lhs, const size_t rhs)
+                { return Bounds[lhs].Min < Bounds[rhs].Min; });
+      std::sort(MaxSorted.begin(), MaxSorted.end(), [this](const size_t lhs, const size_t rhs)
+                { return Bounds[lhs].Max < Bounds[rhs].Max; });
+      Limits.assign((2U * n) + 2U, 0);
+      bound_t low = Bounds[MinSorted.front()].Min;
+      bound_t high = Bounds[MaxSorted.front()].Max + 1;
+      bound_t last = low - 2;
+      size_t count = 0U;
+      Limits[0U] = last;
+      for (size_t i = 0U, j = 0U; j < n;)
+      {
+        if ((i < n) && (low <= high))
+        {
+          if (low != last)
           {
-            // Mémorise le contexte et le choix pour le backtracking
-            selectVariableAndValue(parameters);
+            Limits[++count] = last = low;
+          }
+          Bounds[MinSorted[i]].MinRank = count;
+          if (++i < n)
+          {
+            low = Bounds[MinSorted[i]].Min;
           }
         }
-        else 
+        else
         {
-          // Aucune variable 
-          sastified = false;
+          if (high != last)
+          {
+            Limits[++count] = last = high;
+          }
+          Bounds[MaxSorted[j]].MaxRank = count;
+          if (++j < n)
+          {
+            high = Bounds[MaxSorted[j]].Max + 1;
+          }
         }
-        isSolution = sastified && !isPartialSolution;
+      }
+      Limits[count + 1U] = Limits[count] + 2;
+      Limits.resize(count + 2U);
+      Tree.resize(count + 2U);
+      Hall.resize(count + 2U);
+      Capacity.resize(count + 2U);
+    }
 
-        // Mauvais choix ou recherche d'une autre solution, réinitialise les variables
-        if ((!sastified) && (!parameters.Backup.empty()))
+    // Variables par Max croissant : chacune occupe la première valeur libre à partir de son Min. Un intervalle saturé
+    // est un intervalle de Hall, le Min des variables qui commencent dedans passe après lui.
+    bool raiseLower()
+    {
+      const size_t last = Limits.size() - 1U;
+      for (size_t i = 1U; i <= last; ++i)
+      {
+        Tree[i] = i - 1U;
+        Hall[i] = i - 1U;
+        Capacity[i] = Limits[i] - Limits[i - 1U];
+      }
+      for (const size_t k : MaxSorted)
+      {
+        bounds_t &bounds = Bounds[k];
+        const size_t x = bounds.MinRank;
+        const size_t y = bounds.MaxRank;
+        size_t z = pathMax(Tree, x + 1U);
+        const size_t j = Tree[z];
+        if (--Capacity[z] == 0)
+        {
+          Tree[z] = z + 1U;
+          z = pathMax(Tree, Tree[z]);
+          Tree[z] = j;
+        }
+        pathSet(Tree, x + 1U, z, z);
+        if (Capacity[z] < Limits[z] - Limits[y])
+        {
+          return false;
+        }
+        if (Hall[x] > x)
+        {
+          const size_t w = pathMax(Hall, Hall[x]);
+          bounds.Min = Limits[w];
+          pathSet(Hall, x, w, w);
+        }
+        if (Capacity[z] == Limits[z] - Limits[y])
         {
-          backtracking(parameters);
-          sastified = true;
+          pathSet(Hall, Hall[y], j - 1U, y);
+          Hall[y] = j - 1U;
         }
       }
-      return isSolution;
+      return true;
     }
 
-    std::tuple<bool,bool>
-    partitionAndConstrain(parameters_t& parameters)
+    // Symétrique de raiseLower : variables par Min décroissant, le Max de celles qui finissent dans un intervalle
+    // de Hall passe avant lui
+    bool lowerUpper()
     {
-      // TANT QUE (Existe nouvelles variables instanciées) FAIRE 
-      //   partitionner toutes les nouvelles variables qui sont instanciées parmi les variables du problème
-      //   POUR CHAQUE (Nouvelles variables instanciées)
-      //     POUR CHAQUE (Contraintes)
-      //       Appliquer les contraintes pour réduire le domaine des variables constituant le problème
-      bool sastified = true;
-      bool hasNoInstantiatedVars = true;
-      bool hasInstantiatedVars = true;
-      bool hasAdditionnalVars = false;
-      while (sastified && ((hasInstantiatedVars && hasNoInstantiatedVars) || hasAdditionnalVars))
+      const size_t last = Limits.size() - 1U;
+      for (size_t i = 0U; i < last; ++i)
+      {
+        Tree[i] = i + 1U;
+        Hall[i] = i + 1U;
+        Capacity[i] = Limits[i + 1U] - Limits[i];
+      }
+      for (auto it = MinSorted.rbegin(); it != MinSorted.rend(); ++it)
+      {
+        bounds_t &bounds = Bounds[*it];
+        const size_t x = bounds.MaxRank;
+        const size_t y = bounds.MinRank;
+        size_t z = pathMin(Tree, x - 1U);
+        const size_t j = Tree[z];
+        if (--Capacity[z] == 0)
+        {
+          Tree[z] = z - 1U;
+          z = pathMin(Tree, Tree[z]);
+          Tree[z] = j;
+        }
+        pathSet(Tree, x - 1U, z, z);
+        if (Capacity[z] < Limits[y] - Limits[z])
+        {
+          return false;
+        }
+        if (Hall[x] < x)
+        {
+          const size_t w = pathMin(Hall, Hall[x]);
+          bounds.Max = Limits[w] - 1;
+          pathSet(Hall, x, w, w);
+        }
+        if (Capacity[z] == Limits[y] - Limits[z])
+        {
+          pathSet(Hall, Hall[y], j + 1U, y);
+          Hall[y] = j + 1U;
+        }
+      }
+      return true;
+    }
+
+    static size_t pathMax(const std::vector<size_t> &tree, size_t i)
+    {
+      while (tree[i] > i)
+      {
+        i = tree[i];
+      }
+      return i;
+    }
+
+    static size_t pathMin(const std::vector<size_t> &tree, size_t i)
+    {
+      while (tree[i] < i)
+      {
+        i = tree[i];
+      }
+      return i;
+    }
+
+    // Compression du chemin de start à end : chaque noeud parcouru pointe sur to
+    static void pathSet(std::vector<size_t> &tree, const size_t start, const size_t end, const size_t to)
+    {
+      for (size_t k = start; k != end;)
+      {
+        const size_t next = tree[k];
+        tree[k] = to;
+        k = next;
+      }
+    }
+
+    bool filterDomain(SolverT &solver)
+    {
+      // Graphe biparti variables / valeurs
+      Values.clear();
+      Variables.assign(Indices.size(), nullptr);
+      for (size_t i = 0U; i < Indices.size(); ++i)
+      {
+        Variables[i] = solver.find(Indices[i]);
+        if (Variables[i] != nullptr)
+        {
+          Values.insert(Values.end(), Variables[i]->domain().begin(), Variables[i]->domain().end());
+        }
+      }
+      std::sort(Values.begin(), Values.end());
+      Values.erase(std::unique(Values.begin(), Values.end()), Values.end());
+      Adjacency.resize(Indices.size());
+      Reverse.resize(Values.size());
+      for (std::vector<size_t> &variables : Reverse)
+      {
+        variables.clear();
+      }
+      for (size_t i = 0U; i < Indices.size(); ++i)
       {
-        // Ajout des nouvelles variables créées pendant la recherche
-        for (const indice_t &newIndice : AdditionalIndices)
+        Adjacency[i].clear();
+        if (Variables[i] != nullptr)
         {
-          if (auto &&it = Variables.find(newIndice); it != Variables.cend())
+          for (const value_t value : Variables[i]->domain())
           {
-            parameters.Processing.push_back(it->second);
+            const size_t j = position(value);
+            Adjacency[i].push_back(j);
+            Reverse[j].push_back(i);
           }
         }
-        parameters.Register.insert(parameters.Register.end(), AdditionalIndices.begin(), AdditionalIndices.end());
-        // Partition des variables
-        list_cref_variable_t instantiatedVars;
-        list_cref_variable_t noInstantiatedVars;
-        std::partition_copy(parameters.Processing.begin(), parameters.Processing.end(),
-                            std::back_inserter(instantiatedVars),
-                            std::back_inserter(noInstantiatedVars),
-                            [](const variable_t &var)
-                            { return var.isInstantiated(); });
-        hasInstantiatedVars = (!instantiatedVars.empty());
-        hasNoInstantiatedVars = (!noInstantiatedVars.empty());
-        // Applique les contraintes
-        for (const variable_t &var : instantiatedVars)
+      }
+      // Couplage maximum à partir du couplage précédent
+      if (!match())
+      {
+        return false;
+      }
+      // Arcs du couplage : variable -> valeur, autres arcs : valeur -> variable
+      const size_t n = Indices.size();
+      const size_t m = Values.size();
+      Reached.assign(n + m, false);
+      Stack.clear();
+      for (size_t j = 0U; j < m; ++j)
+      {
+        if (Owner[j] == Free)
+        {
+          Reached[n + j] = true;
+          Stack.push_back(n + j);
+        }
+      }
+      while (!Stack.empty())
+      {
+        const size_t node = Stack.back();
+        Stack.pop_back();
+        forEachSuccessor(node, [this](const size_t next)
+                         {
+                           if (!Reached[next])
+                           {
+                             Reached[next] = true;
+                             Stack.push_back(next);
+                           }
+                         });
+      }
+      components();
+      // Un arc hors couplage est conservé s'il appartient à un chemin alternant issu d'une valeur libre
+      // ou à un cycle alternant (même composante fortement connexe)
+      bool sastified = true;
+      for (size_t i = 0U; (i < n) && sastified; ++i)
+      {
+        for (const size_t j : Adjacency[i])
         {
-          for (const constraint_t &constraint : Constraints)
+          if ((j != Match[i]) && !Reached[n + j] && (Component[i] != Component[n + j]))
           {
-            sastified = constraint(*this, var.indice(), var.value());
-            if (!sastified)
-              break;
+            Removed.push_back(Values[j]);
           }
-          if (!sastified)
-            break;
         }
-        hasAdditionnalVars = (!AdditionalIndices.empty());
-        // Recommencer tant qu'il y a des nouvelles variables instanciées parmi celles non instanciées
-        parameters.Processing = noInstantiatedVars;
+        for (const value_t value : Removed)
+        {
+          sastified = sastified && solver.exclude(value, Indices[i]);
+        }
+        Removed.clear();
       }
-      return std::make_tuple(sastified, sastified && hasNoInstantiatedVars);
+      return sastified;
     }
 
-    void
-    selectVariableAndValue(parameters_t& parameters) const
+    size_t position(const value_t value) const
     {
-      // Trie des variables et sélection de la première variable
-      if (Comparator)
+      return static_cast<size_t>(std::lower_bound(Values.begin(), Values.end(), value) - Values.begin());
+    }
+
+    bool match()
+    {
+      const size_t n = Indices.size();
+      Match.assign(n, Free);
+      Owner.assign(Values.size(), Free);
+      for (size_t i = 0U; i < n; ++i)
       {
-        std::sort(parameters.Processing.begin(), parameters.Processing.end(), Comparator);
+        if (Matched[i].has_value() && (Variables[i] != nullptr))
+        {
+          if (Variables[i]->canBe(*Matched[i]))
+          {
+            const size_t j = position(*Matched[i]);
+            if (Owner[j] == Free)
+            {
+              Match[i] = j;
+              Owner[j] = i;
+            }
+          }
+        }
       }
-      variable_t& var = parameters.Processing.front();
-      // Sélectionne la valeur
-      value_t val = var.value();
-      if (Selector)
+      bool complete = true;
+      for (size_t i = 0U; (i < n) && complete; ++i)
       {
-        val = Selector(var);
+        if ((Match[i] == Free) && (Variables[i] != nullptr))
+        {
+          Visited.assign(Values.size(), false);
+          complete = augment(i);
+        }
       }
-      // Copie du contexte
-      record_t save;
-      save.Register = parameters.Register;
-      save.RemainingVariables.reserve(parameters.Processing.size());
-      save.RemainingVariables.assign(parameters.Processing.begin(), parameters.Processing.end());
-      save.ChoiceIndice = var.indice();
-      save.ChoiceValue = val;
-      // Définit le choix de la valeur
-      var.set(val);
-      //std::cout << "try (" << copyIndice.X << ", " << copyIndice.Y << ") = " << copyVal << std::endl;
-      parameters.Backup.emplace_back(std::move(save));
+      for (size_t i = 0U; i < n; ++i)
+      {
+        Matched[i] = (Match[i] == Free) ? std::nullopt : std::optional<value_t>(Values[Match[i]]);
+      }
+      return complete;
     }
 
-    void 
-    backtracking(parameters_t& parameters)
+    // Recherche d'un chemin augmentant depuis la variable i, en profondeur avec une pile explicite :
+    // chaque variable de Frames a quitté la valeur qui précède son rang et la cède à la suivante
+    bool augment(const size_t i)
     {
-      record_t save = parameters.Backup.back();
-      parameters.Backup.pop_back();
-      // Copier les variables non viables
-      auto &&it = parameters.Register.begin();    
-      std::advance(it, save.Register.size());
-      for (; it != parameters.Register.end(); ++it)
+      Frames.clear();
+      Frames.emplace_back(i, 0U);
+      while (!Frames.empty())
       {
-        RejectedIndices.insert(*it);
-        Variables.erase(*it);
+        const size_t var = Frames.back().first;
+        const size_t k = Frames.back().second;
+        if (k == Adjacency[var].size())
+        {
+          Frames.pop_back();
+          continue;
+        }
+        ++Frames.back().second;
+        const size_t j = Adjacency[var][k];
+        if (Visited[j])
+        {
+          continue;
+        }
+        Visited[j] = true;
+        if (Owner[j] != Free)
+        {
+          Frames.emplace_back(Owner[j], 0U);
+          continue;
+        }
+        for (const auto &[owner, next] : Frames)
+        {
+          Match[owner] = Adjacency[owner][next - 1U];
+          Owner[Match[owner]] = owner;
+        }
+        return true;
       }
-      for (it = AdditionalIndices.begin(); it != AdditionalIndices.end(); ++it)
+      return false;
+    }
+
+    // Arcs candidats du graphe orienté par le couplage : variable -> valeur couplée, valeur -> variables non couplées
+    // à elle. successor(node, k) vaut Free si le k-ième candidat n'est pas un arc.
+    size_t degree(const size_t node) const
+    {
+      const size_t n = Indices.size();
+      return (node < n) ? 1U : Reverse[node - n].size();
+    }
+
+    size_t successor(const size_t node, const size_t k) const
+    {
+      const size_t n = Indices.size();
+      if (node < n)
       {
-        RejectedIndices.insert(*it);
-        Variables.erase(*it);
+        return (Match[node] == Free) ? Free : n + Match[node];
       }
-      // Restaure les variables
-      parameters.Processing.clear();
-      parameters.Processing.reserve(save.RemainingVariables.size());
-      for (auto&& var : save.RemainingVariables)
+      const size_t i = Reverse[node - n][k];
+      return (Match[i] == node - n) ? Free : i;
+    }
+
+    template <class FctT>
+    void forEachSuccessor(const size_t node, FctT &&fct) const
+    {
+      for (size_t k = 0U; k < degree(node); ++k)
       {
-        if (auto &&it = Variables.find(var.indice()); it != Variables.end())
+        if (const size_t next = successor(node, k); next != Free)
         {
-          it->second = var;
-          parameters.Processing.push_back(it->second);
+          fct(next);
         }
       }
-      parameters.Register = std::move(save.Register);
-      AdditionalIndices.clear();
-      // Elimine la valeur déjà analysée de la variable
-      if (auto &&it = Variables.find(save.ChoiceIndice); it != Variables.end())
+    }
+
+    // Composantes fortement connexes (Tarjan)
+    void components()
+    {
+      const size_t size = Indices.size() + Values.size();
+      Component.assign(size, Free);
+      Order.assign(size, Free);
+      Low.assign(size, 0U);
+      OnStack.assign(size, false);
+      Stack.clear();
+      Stamp = 0U;
+      for (size_t node = 0U; node < size; ++node)
       {
-        it->second.exclude(save.ChoiceValue);
+        if (Order[node] == Free)
+        {
+          connect(node);
+        }
       }
-      //std::cout << "backtracking (" << indice.X << ", " << indice.Y << ") = " << val << std::endl;
     }
 
-    bool IsSolveInProgress;
-    comparator_t Comparator;
-    selector_t Selector;
-    std::list<constraint_t> Constraints;
-    map_variable_t Variables;
-    list_indice_t AdditionalIndices;
-    set_indice_t RejectedIndices;
-    solution_list_t SolutionList;
+    // Parcours de Tarjan depuis root avec une pile explicite (Frames : noeud et rang de son prochain arc)
+    void connect(const size_t root)
+    {
+      open(root);
+      Frames.clear();
+      Frames.emplace_back(root, 0U);
+      while (!Frames.empty())
+      {
+        const size_t node = Frames.back().first;
+        const size_t k = Frames.back().second;
+        if (k < degree(node))
+        {
+          ++Frames.back().second;
+          const size_t next = successor(node, k);
+          if (next == Free)
+          {
+            continue;
+          }
+          if (Order[next] == Free)
+          {
+            open(next);
+            Frames.emplace_back(next, 0U);
+          }
+          else if (OnStack[next])
+          {
+            Low[node] = std::min(Low[node], Order[next]);
+          }
+          continue;
+        }
+        Frames.pop_back();
+        if (Low[node] == Order[node])
+        {
+          size_t top = Free;
+          do
+          {
+            top = Stack.back();
+            Stack.pop_back();
+            OnStack[top] = false;
+            Component[top] = node;
+          } while (top != node);
+        }
+        if (!Frames.empty())
+        {
+          const size_t parent = Frames.back().first;
+          Low[parent] = std::min(Low[parent], Low[node]);
+        }
+      }
+    }
+
+    void open(const size_t node)
+    {
+      Order[node] = Stamp;
+      Low[node] = Stamp;
+      ++Stamp;
+      Stack.push_back(node);
+      OnStack[node] = true;
+    }
+
+    std::vector<indice_t> Indices;
+    Consistency Level;
+    // Valeur couplée à chaque variable lors du dernier appel
+    std::vector<std::optional<value_t>> Matched;
+    // Données de travail conservées pour éviter les allocations
+    std::vector<bounds_t> Bounds;
+    std::vector<size_t> MinSorted;
+    std::vector<size_t> MaxSorted;
+    std::vector<bound_t> Limits;
+    std::vector<size_t> Tree;
+    std::vector<size_t> Hall;
+    std::vector<bound_t> Capacity;
+    std::vector<const typename SolverT::variable_t *> Variables;
+    std::vector<value_t> Values;
+    std::vector<std::vector<size_t>> Adjacency;
+    std::vector<std::vector<size_t>> Reverse;
+    std::vector<size_t> Match;
+    std::vector<size_t> Owner;
+    std::vector<bool> Visited;
+    std::vector<bool> Reached;
+    std::vector<size_t> Stack;
+    std::vector<size_t> Component;
+    std::vector<size_t> Order;
+    std::vector<size_t> Low;
+    std::vector<bool> OnStack;
+    std::vector<value_t> Removed;
+    // Pile des parcours en profondeur (augment, connect) : noeud et rang de son prochain arc
+    std::vector<std::pair<size_t, size_t>> Frames;
+    // Rang de visite suivant du parcours de Tarjan
+    size_t Stamp = 0U;
   };
+
+  // Ajoute une contrainte AllDifferent abonnée aux événements correspondant à son niveau de filtrage
+  template <class SolverT>
+  void
+  addAllDifferent(SolverT &solver, const std::vector<typename SolverT::indice_t> &indices, const Consistency consistency = Consistency::Bounds)
+  {
+    AllDifferent<SolverT> constraint(indices, consistency);
+    const Event events = constraint.events();
+    solver.addConstraint(std::move(constraint), indices, events);
+  }
 }
 
 #endif
@@ -1,58 +1,103 @@
-
 #ifndef DEPENDENCY_GRAPH_H
 #define DEPENDENCY_GRAPH_H
 
-#include <stack>
 #include <map>
+#include <optional>
+#include <utility>
 #include <vector>
-#include <set>
 #include <concepts>
- 
+
+// Graphe de dépendances : addDependency(u, v) indique que u dépend de v.
+// Les sommets sont numérotés de façon dense dans l'ordre d'insertion, la décomposition en niveaux est itérative
+// (aucun risque de débordement de pile sur les longues chaînes) et un cycle est signalé explicitement.
 template<std::totally_ordered T>
 class DependencyGraph {
 private:
-  std::map<T, std::vector<T> > graph; 
-  std::set<T> vertices;
+  // Rang dense de chaque sommet (parcouru dans l'ordre des sommets)
+  std::map<T, size_t> indices;
+  std::vector<T> vertices;
+  std::vector<std::vector<size_t>> dependencies;
+
 public:
   DependencyGraph()
   {}
 
-  void addDependency(const T& u, const T& v) 
-  { 
-    vertices.insert(u);
-    vertices.insert(v);
-    graph[u].push_back(v); 
+  void addDependency(const T& u, const T& v)
+  {
+    const size_t from = rank(u);
+    const size_t to = rank(v);
+    dependencies[from].push_back(to);
   }
- 
-  std::vector<T> topologicalSort()
+
+  size_t size() const
   {
-    std::set<T> visited; 
-    std::vector<T> sorted;
-    sorted.reserve(vertices.size());
+    return vertices.size();
+  }
 
-    for (auto&& vertice: vertices)
+  // Décomposition en niveaux (algorithme de Kahn) : le niveau 0 regroupe les sommets sans dépendance,
+  // le niveau k les sommets dont les dépendances sont toutes de niveau inférieur et dont au moins une est de niveau k - 1.
+  // Mis bout à bout, les niveaux donnent chaque sommet après ceux dont il dépend. std::nullopt si le graphe contient un cycle.
+  std::optional<std::vector<std::vector<T>>> levels() const
+  {
+    // Sommets dépendant de chaque sommet et nombre de dépendances non encore placées
+    std::vector<std::vector<size_t>> dependents(vertices.size());
+    std::vector<size_t> remaining(vertices.size(), 0U);
+    for (size_t u = 0U; u < vertices.size(); ++u)
+    {
+      for (const size_t v : dependencies[u])
+      {
+        dependents[v].push_back(u);
+        ++remaining[u];
+      }
+    }
+    std::vector<std::vector<T>> result;
+    std::vector<size_t> current;
+    for (auto&& [vertice, v] : indices)
+    {
+      if (remaining[v] == 0U)
+      {
+        current.push_back(v);
+      }
+    }
+    size_t placed = 0U;
+    std::vector<size_t> next;
+    while (!current.empty())
     {
-      if (!visited.contains(vertice))
+      std::vector<T>& level = result.emplace_back();
+      level.reserve(current.size());
+      next.clear();
+      for (const size_t v : current)
       {
-        parseDependencies(vertice, visited, sorted);
+        level.push_back(vertices[v]);
+        for (const size_t u : dependents[v])
+        {
+          if (--remaining[u] == 0U)
+          {
+            next.push_back(u);
+          }
+        }
       }
+      placed += current.size();
+      std::swap(current, next);
     }
-    return sorted;
+    if (placed != vertices.size())
+    {
+      return std::nullopt;
+    }
+    return result;
   }
- 
+
 private:
-  void parseDependencies(const T& vertice, std::set<T>& visited, std::vector<T>& stack)
+  size_t rank(const T& vertice)
   {
-    visited.insert(vertice);
-    for (auto&& depends: graph[vertice])
+    const auto [it, inserted] = indices.try_emplace(vertice, vertices.size());
+    if (inserted)
     {
-      if (!visited.contains(depends))
-      {
-        parseDependencies(depends, visited, stack);
-      }
+      vertices.push_back(vertice);
+      dependencies.emplace_back();
     }
-    stack.push_back(vertice);
+    return it->second;
   }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,274 @@
+#ifndef DOMAIN_POLICY_H
+#define DOMAIN_POLICY_H
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+
+namespace solver
+{
+
+  // Une valeur de domaine doit être ordonnée et discrète (entier ou énumération)
+  template <class T>
+  concept ordered_value = std::totally_ordered<T> and (std::is_integral_v<T> or std::is_enum_v<T>);
+
+  // Une politique de domaine stocke un ensemble de valeurs uniques et ordonnées.
+  // Le parcours (begin/end) se fait dans l'ordre croissant des valeurs.
+  template <class D, class V>
+  concept domain_policy = std::default_initializable<D> and std::copyable<D> and
+    requires(D d, const D cd, const V v)
+    {
+      { cd.size() } -> std::convertible_to<size_t>;
+      { cd.empty() } -> std::convertible_to<bool>;
+      { cd.contains(v) } -> std::convertible_to<bool>;
+      { cd.min() } -> std::convertible_to<V>;
+      { cd.max() } -> std::convertible_to<V>;
+      { *cd.begin() } -> std::convertible_to<V>;
+      cd.end();
+      d.erase(v);
+      d.insert(v);
+      d.assign(v);
+    };
+
+  // Domaine générique : utilisation du type std::set car le nombre de valeurs
+  // constituant le domaine est supposé inférieur à 100.
+  template <ordered_value ValueT>
+  class SetDomain
+  {
+  public:
+    using value_type = ValueT;
+    using const_iterator = typename std::set<ValueT>::const_iterator;
+
+    SetDomain() = default;
+
+    template <class It>
+    SetDomain(It first, It last)
+        : Values(first, last)
+    {
+    }
+
+    SetDomain(std::initializer_list<ValueT> values)
+        : Values(values)
+    {
+    }
+
+    size_t size() const
+    {
+      return Values.size();
+    }
+
+    bool empty() const
+    {
+      return Values.empty();
+    }
+
+    bool contains(const ValueT value) const
+    {
+      return Values.contains(value);
+    }
+
+    ValueT min() const
+    {
+      return *(Values.begin());
+    }
+
+    ValueT max() const
+    {
+      return *(Values.rbegin());
+    }
+
+    void erase(const ValueT value)
+    {
+      Values.erase(value);
+    }
+
+    void insert(const ValueT value)
+    {
+      Values.insert(value);
+    }
+
+    void assign(const ValueT value)
+    {
+      Values.clear();
+      Values.insert(value);
+    }
+
+    // Estimation de la mémoire allouée sur le tas (un noeud d'arbre par valeur)
+    size_t footprint() const
+    {
+      return Values.size() * (sizeof(ValueT) + 4U * sizeof(void *));
+    }
+
+    const_iterator begin() const
+    {
+      return Values.begin();
+    }
+
+    const_iterator end() const
+    {
+      return Values.end();
+    }
+
+  private:
+    std::set<ValueT> Values;
+  };
+
+  // Domaine à taille fixe : chaque valeur v de [0, MaxValue] est représentée par le bit v d'un mot machine.
+  // Adapté aux petits intervalles d'entiers (1..9, 1..16, 1..25) :
+  // - size() par popcount
+  // - min() par comptage des zéros de poids faible
+  // - erase()/insert()/assign()/contains() par simple masque
+  template <ordered_value ValueT, size_t MaxValue>
+  class BitsetDomain
+  {
+    static_assert(MaxValue < 64U, "BitsetDomain is limited to values in [0, 63]");
+
+  public:
+    using value_type = ValueT;
+    using word_t = std::conditional_t<(MaxValue < 32U), std::uint32_t, std::uint64_t>;
+
+    static constexpr size_t Width = std::numeric_limits<word_t>::digits;
+
+    class const_iterator
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = ValueT;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = ValueT;
+
+      const_iterator() = default;
+
+      explicit const_iterator(const word_t bits)
+          : Bits(bits)
+      {
+      }
+
+      ValueT operator*() const
+      {
+        return static_cast<ValueT>(std::countr_zero(Bits));
+      }
+
+      const_iterator &operator++()
+      {
+        Bits &= (Bits - 1U);
+        return *this;
+      }
+
+      const_iterator operator++(int)
+      {
+        const_iterator copy = *this;
+        ++(*this);
+        return copy;
+      }
+
+      bool operator==(const const_iterator &rhs) const = default;
+
+    private:
+      word_t Bits = 0U;
+    };
+
+    BitsetDomain() = default;
+
+    template <class It>
+    BitsetDomain(It first, It last)
+    {
+      for (; first != last; ++first)
+      {
+        Bits |= mask(*first);
+      }
+    }
+
+    BitsetDomain(std::initializer_list<ValueT> values)
+        : BitsetDomain(values.begin(), values.end())
+    {
+    }
+
+    size_t size() const
+    {
+      return static_cast<size_t>(std::popcount(Bits));
+    }
+
+    bool empty() const
+    {
+      return (Bits == 0U);
+    }
+
+    bool contains(const ValueT value) const
+    {
+      const size_t bit = static_cast<size_t>(value);
+      return (bit <= MaxValue) && ((Bits >> bit) & 1U);
+    }
+
+    ValueT min() const
+    {
+      return static_cast<ValueT>(std::countr_zero(Bits));
+    }
+
+    ValueT max() const
+    {
+      return static_cast<ValueT>(Width - 1U - static_cast<size_t>(std::countl_zero(Bits)));
+    }
+
+    void erase(const ValueT value)
+    {
+      if (static_cast<size_t>(value) <= MaxValue)
+      {
+        Bits &= ~mask(value);
+      }
+    }
+
+    void insert(const ValueT value)
+    {
+      Bits |= mask(value);
+    }
+
+    void assign(const ValueT value)
+    {
+      Bits = mask(value);
+    }
+
+    word_t bits() const
+    {
+      return Bits;
+    }
+
+    // Aucune allocation sur le tas
+    size_t footprint() const
+    {
+      return 0U;
+    }
+
+    const_iterator begin() const
+    {
+      return const_iterator{Bits};
+    }
+
+    const_iterator end() const
+    {
+      return const_iterator{};
+    }
+
+  private:
+    static word_t mask(const ValueT value)
+    {
+      const size_t bit = static_cast<size_t>(value);
+      if (bit > MaxValue)
+      {
+        throw std::out_of_range("Value is out of the bitset domain.");
+      }
+      return static_cast<word_t>(word_t{1U} << bit);
+    }
+
+    word_t Bits = 0U;
+  };
+}
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef GRID_LOADER_H
+#define GRID_LOADER_H
+
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <istream>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace solver
+{
+
+  // Tailles résolues par des noyaux instanciés à la compilation (domaines en bitset, masques du moteur spécialisé),
+  // les autres tailles passent par un modèle dont la taille n'est connue qu'à l'exécution
+  constexpr size_t KernelMinSize = 4U;
+  constexpr size_t KernelMaxSize = 16U;
+
+  // Plus grande valeur d'une case de grille texte
+  constexpr size_t TextMaxValue = 35U;
+
+  // Case d'une grille texte : '0' ou '.' pour une case vide, '1' à '9' puis 'A' (10) à 'Z' (35)
+  constexpr std::optional<size_t>
+  cellValue(const char c)
+  {
+    std::optional<size_t> value;
+    if (c == '.')
+    {
+      value = 0U;
+    }
+    else if ((c >= '0') && (c <= '9'))
+    {
+      value = static_cast<size_t>(c - '0');
+    }
+    else if ((c >= 'A') && (c <= 'Z'))
+    {
+      value = static_cast<size_t>(c - 'A') + 10U;
+    }
+    return value;
+  }
+
+  constexpr char
+  cellChar(const size_t value)
+  {
+    return (value < 10U) ? static_cast<char>('0' + value) : static_cast<char>('A' + (value - 10U));
+  }
+
+  namespace loader_detail
+  {
+    template <size_t Min, class FctT, size_t... I>
+    bool
+    dispatch(const size_t n, FctT &fct, std::index_sequence<I...>)
+    {
+      return ((n == Min + I ? (fct(std::integral_constant<size_t, Min + I>{}), true) : false) || ...);
+    }
+  }
+
+  // Appelle fct(std::integral_constant<size_t, N>{}) avec N == n, le noyau de chaque taille de [Min, Max] étant instancié
+  // à la compilation. Retourne false si n est hors de l'intervalle : l'appelant passe alors au modèle dynamique.
+  template <size_t Min, size_t Max, class FctT>
+  bool
+  dispatchSize(const size_t n, FctT &&fct)
+  {
+    static_assert(Min <= Max);
+    return loader_detail::dispatch<Min>(n, fct, std::make_index_sequence<Max - Min + 1U>{});
+  }
+
+  // Entrée d'un traitement par lots : un fichier texte, ou l'entrée standard pour "-"
+  class GridInput
+  {
+  public:
+    bool
+    open(const std::string &path)
+    {
+      Standard = (path == "-");
+      if (!Standard)
+      {
+        File.open(path);
+      }
+      return Standard || File.is_open();
+    }
+
+    std::istream &
+    stream()
+    {
+      return Standard ? std::cin : File;
+    }
+
+  private:
+    std::ifstream File;
+    bool Standard = false;
+  };
+}
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef INEQUALITIES_H
+#define INEQUALITIES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "constraintSolver.h"
+
+namespace solver
+{
+
+  // Inégalités strictes d'une variable avec ses voisines du graphe des inégalités (inf < sup), filtrées aux bornes.
+  // Le propagateur ne resserre que les bornes de sa variable ; il surveille les bornes de la variable et de ses voisines,
+  // si bien qu'une borne modifiée ne réveille que les propagateurs des extrémités concernées et que la file du solveur
+  // pousse les nouvelles bornes le long du graphe jusqu'au point fixe.
+  // Les voisines d'un même groupe prennent des valeurs différentes (même ligne d'un carré latin par exemple) :
+  // k variables supérieures d'un même groupe imposent var <= max(groupe) - k, k inférieures var >= min(groupe) + k.
+  template <class SolverT>
+    requires std::is_integral_v<typename SolverT::value_t>
+  class Inequalities
+  {
+  public:
+    using indice_t = typename SolverT::indice_t;
+    using value_t = typename SolverT::value_t;
+
+    explicit Inequalities(const indice_t &indice)
+        : Indice(indice)
+    {
+    }
+
+    // sup : variable strictement supérieure, group : groupe de variables différentes auquel elle appartient
+    void addSuperior(const indice_t &sup, const size_t group)
+    {
+      Superiors.push_back(neighbour_t{sup, group});
+    }
+
+    void addInferior(const indice_t &inf, const size_t group)
+    {
+      Inferiors.push_back(neighbour_t{inf, group});
+    }
+
+    // Variable et voisines, à surveiller pour l'événement BoundsChanged
+    std::vector<indice_t> indices() const
+    {
+      std::vector<indice_t> watched{Indice};
+      for (const neighbour_t &neighbour : Superiors)
+      {
+        watched.push_back(neighbour.Indice);
+      }
+      for (const neighbour_t &neighbour : Inferiors)
+      {
+        watched.push_back(neighbour.Indice);
+      }
+      return watched;
+    }
+
+    bool operator()(SolverT &solver, const indice_t, const value_t)
+    {
+      const auto *var = solver.find(Indice);
+      if (var == nullptr)
+      {
+        return true;
+      }
+      bound_t upper = std::numeric_limits<bound_t>::max();
+      bound_t lower = std::numeric_limits<bound_t>::min();
+      // Voisines regroupées : chaque groupe est un intervalle contigu
+      for (auto first = Superiors.begin(); first != Superiors.end();)
+      {
+        bound_t lowest = std::numeric_limits<bound_t>::max();
+        bound_t highest = std::numeric_limits<bound_t>::min();
+        bound_t count = 0;
+        auto last = first;
+        for (; (last != Superiors.end()) && (last->Group == first->Group); ++last)
+        {
+          if (const auto *sup = solver.find(last->Indice); sup != nullptr)
+          {
+            lowest = std::min(lowest, static_cast<bound_t>(sup->domain().max()));
+            highest = std::max(highest, static_cast<bound_t>(sup->domain().max()));
+            ++count;
+          }
+        }
+        if (count > 0)
+        {
+          upper = std::min({upper, lowest - 1, highest - count});
+        }
+        first = last;
+      }
+      for (auto first = Inferiors.begin(); first != Inferiors.end();)
+      {
+        bound_t lowest = std::numeric_limits<bound_t>::max();
+        bound_t highest = std::numeric_limits<bound_t>::min();
+        bound_t count = 0;
+        auto last = first;
+        for (; (last != Inferiors.end()) && (last->Group == first->Group); ++last)
+        {
+          if (const auto *inf = solver.find(last->Indice); inf != nullptr)
+          {
+            lowest = std::min(lowest, static_cast<bound_t>(inf->domain().min()));
+            highest = std::max(highest, static_cast<bound_t>(inf->domain().min()));
+            ++count;
+          }
+        }
+        if (count > 0)
+        {
+          lower = std::max({lower, highest + 1, lowest + count});
+        }
+        first = last;
+      }
+      // Valeurs hors de [lower, upper] retirées par les bornes : l'exclusion de la dernière valeur échoue
+      bool sastified = true;
+      while (sastified && (static_cast<bound_t>(var->domain().max()) > upper))
+      {
+        sastified = solver.exclude(var->domain().max(), Indice);
+      }
+      while (sastified && (static_cast<bound_t>(var->domain().min()) < lower))
+      {
+        sastified = solver.exclude(var->domain().min(), Indice);
+      }
+      return sastified;
+    }
+
+    // Regroupe les voisines d'un même groupe
+    void sort()
+    {
+      const auto byGroup = [](const neighbour_t &lhs, const neighbour_t &rhs)
+      { return lhs.Group < rhs.Group; };
+      std::stable_sort(Superiors.begin(), Superiors.end(), byGroup);
+      std::stable_sort(Inferiors.begin(), Inferiors.end(), byGroup);
+    }
+
+  private:
+    using bound_t = std::intmax_t;
+
+    struct neighbour_t
+    {
+      indice_t Indice;
+      size_t Group;
+    };
+
+    indice_t Indice;
+    std::vector<neighbour_t> Superiors;
+    std::vector<neighbour_t> Inferiors;
+  };
+
+  // Ajoute les inégalités strictes inf < sup : un propagateur aux bornes par variable reliée.
+  // group(var, voisine) désigne le groupe de la voisine vue de var, les voisines d'un même groupe étant différentes.
+  template <class SolverT, class GroupT>
+  void
+  addInequalities(SolverT &solver, const std::vector<std::pair<typename SolverT::indice_t, typename SolverT::indice_t>> &arcs, GroupT &&group)
+  {
+    std::map<typename SolverT::indice_t, Inequalities<SolverT>> propagators;
+    for (const auto &[inf, sup] : arcs)
+    {
+      propagators.try_emplace(inf, inf).first->second.addSuperior(sup, group(inf, sup));
+      propagators.try_emplace(sup, sup).first->second.addInferior(inf, group(sup, inf));
+    }
+    for (auto &[indice, propagator] : propagators)
+    {
+      propagator.sort();
+      const std::vector<typename SolverT::indice_t> watched = propagator.indices();
+      solver.addConstraint(std::move(propagator), watched, Event::BoundsChanged);
+    }
+  }
+
+  // Sans groupe : chaque voisine est seule dans son groupe
+  template <class SolverT>
+  void
+  addInequalities(SolverT &solver, const std::vector<std::pair<typename SolverT::indice_t, typename SolverT::indice_t>> &arcs)
+  {
+    size_t next = 0U;
+    addInequalities(solver, arcs, [&next](const typename SolverT::indice_t &, const typename SolverT::indice_t &)
+                    { return next++; });
+  }
+}
+
+#endif
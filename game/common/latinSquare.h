@@ -0,0 +1,526 @@
+#ifndef LATIN_SQUARE_H
+#define LATIN_SQUARE_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "carre.h"
+
+namespace solver
+{
+
+  // Mot de N bits : le bit v-1 représente la valeur v
+  template <size_t N>
+  using latin_mask_t = std::conditional_t<(N <= 16U), std::uint16_t,
+                                          std::conditional_t<(N <= 32U), std::uint32_t, std::uint64_t>>;
+
+  // Moteur spécialisé pour les carrés latins N x N de valeurs 1..N, avec des blocs B x B (sudoku, N = B * B)
+  // ou sans bloc (B = 0) et des inégalités entre cases (futoshiki).
+  // Chaque case a un masque de candidats, chaque ligne, colonne et bloc le masque des valeurs placées.
+  // Pendant la recherche, un placement retire sa valeur aux cases voisines (table constante) et signale les nouveaux
+  // singletons ; une valeur imposée ne change que les masques de ses unités, les candidats en sont privés par un seul
+  // balayage au début de la recherche. Les singletons cachés d'une unité se déduisent des masques "au moins une fois" et "au moins deux fois"
+  // de ses cases, les inégalités bornent les masques. Ces opérations portent sur des tableaux contigus de mots
+  // de même taille, que le compilateur peut vectoriser. La propagation reprend tant qu'un singleton caché est placé.
+  // La recherche choisit la case ayant le moins de candidats (la première en cas d'égalité) et essaie
+  // les valeurs par ordre croissant, comme le comparateur et le sélecteur des programmes sudoku et futoshiki.
+  // Pour une grille n'ayant qu'une solution, les deux moteurs donnent donc le même résultat ; sinon
+  // la première solution trouvée peut différer, les égalités du comparateur n'étant pas départagées de la même façon.
+  template <size_t N, size_t B = 0U>
+  class LatinSquare
+  {
+    static_assert((N > 0U) && (N <= 64U), "LatinSquare is limited to N in [1, 64]");
+    static_assert((B == 0U) || (B * B == N), "LatinSquare blocks must be B x B with N = B * B");
+
+  public:
+    using mask_t = latin_mask_t<N>;
+
+    static constexpr size_t Size = N * N;
+    static constexpr size_t BoxCount = (B == 0U) ? 0U : N;
+    static constexpr mask_t Full = (N == std::numeric_limits<mask_t>::digits) ? static_cast<mask_t>(~mask_t{0U})
+                                                                              : static_cast<mask_t>((mask_t{1U} << N) - 1U);
+
+    LatinSquare()
+    {
+      clear();
+    }
+
+    // Grille vide, sans inégalité
+    void
+    clear()
+    {
+      Root.Candidates.fill(Full);
+      Root.Values.fill(0U);
+      Root.Rows.fill(0U);
+      Root.Columns.fill(0U);
+      Root.Boxes.fill(0U);
+      Root.Empty = Size;
+      Inferiors.clear();
+      Solution = Root;
+      Consistent = true;
+      Nodes = 0U;
+    }
+
+    // Valeur imposée, retourne false si elle contredit les valeurs déjà imposées
+    bool
+    assign(const tda::Coord &coord, const size_t value)
+    {
+      const size_t cell = index(coord);
+      if ((value == 0U) || (value > N) || ((Root.Candidates[cell] & ~taken(Root, cell) & bit(value)) == 0U))
+      {
+        Consistent = Consistent && (value != 0U) && (Root.Values[cell] == value);
+      }
+      else
+      {
+        // seuls les masques des unités changent : les candidats des autres cases en sont privés au début de la recherche
+        fix(Root, cell, bit(value));
+      }
+      return Consistent;
+    }
+
+    // Valeurs d'une case restreintes à [min, max], retourne false si aucune ne reste
+    bool
+    narrow(const tda::Coord &coord, const size_t min, const size_t max)
+    {
+      mask_t mask = 0U;
+      if ((min <= max) && (min <= N) && (max >= 1U))
+      {
+        const size_t first = std::max<size_t>(min, 1U);
+        const size_t last = std::min(max, N);
+        mask = static_cast<mask_t>(static_cast<mask_t>(Full >> (N - last)) & static_cast<mask_t>(Full << (first - 1U)));
+      }
+      // les singletons apparus sont retrouvés au début de la recherche
+      pending_t pending;
+      bool changed = false;
+      Consistent = restrict(Root, index(coord), mask, pending, changed) && Consistent;
+      return Consistent;
+    }
+
+    // Inégalité stricte : valeur(inf) < valeur(sup)
+    void
+    addInferior(const tda::Coord &inf, const tda::Coord &sup)
+    {
+      Inferiors.push_back({static_cast<std::uint16_t>(index(inf)), static_cast<std::uint16_t>(index(sup))});
+    }
+
+    // Recherche la première solution
+    bool
+    solve()
+    {
+      bool found = false;
+      start([this, &found](const state_t &solution)
+      {
+        Solution = solution;
+        found = true;
+        return true;
+      });
+      return found;
+    }
+
+    // Nombre de solutions, limité à limit (0 pour toutes)
+    size_t
+    countSolutions(const size_t limit = 0U)
+    {
+      size_t count = 0U;
+      start([this, &count, limit](const state_t &solution)
+      {
+        if (count == 0U)
+        {
+          Solution = solution;
+        }
+        ++count;
+        return (limit != 0U) && (count >= limit);
+      });
+      return count;
+    }
+
+    // Valeur d'une case de la dernière solution trouvée (0 si aucune)
+    size_t
+    value(const tda::Coord &coord) const
+    {
+      return Solution.Values[index(coord)];
+    }
+
+    // Nombre de points de choix de la dernière recherche
+    size_t
+    choicePoints() const
+    {
+      return Nodes;
+    }
+
+  private:
+    struct state_t
+    {
+      std::array<mask_t, Size> Candidates;   // 0 pour une case placée
+      std::array<std::uint8_t, Size> Values; // 0 pour une case vide
+      std::array<mask_t, N> Rows;
+      std::array<mask_t, N> Columns;
+      std::array<mask_t, (B == 0U) ? 1U : N> Boxes;
+      size_t Empty;
+    };
+
+    // Cases devenues singletons, à placer
+    struct pending_t
+    {
+      std::array<std::uint16_t, Size> Cells;
+      size_t Count = 0U;
+    };
+
+    struct inferior_t
+    {
+      std::uint16_t Inf;
+      std::uint16_t Sup;
+    };
+
+    // Ligne, colonne et bloc de chaque case
+    struct cell_t
+    {
+      std::uint16_t Row;
+      std::uint16_t Column;
+      std::uint16_t Box;
+    };
+
+    static constexpr std::array<cell_t, Size> Cells = []
+    {
+      std::array<cell_t, Size> cells{};
+      for (size_t cell = 0U; cell < Size; ++cell)
+      {
+        const size_t box = (B == 0U) ? 0U : (((cell / N) / B) * B + ((cell % N) / B));
+        cells[cell] = {static_cast<std::uint16_t>(cell / N), static_cast<std::uint16_t>(cell % N), static_cast<std::uint16_t>(box)};
+      }
+      return cells;
+    }();
+
+    // Unités : lignes, colonnes puis blocs
+    static constexpr size_t UnitCount = (2U * N) + BoxCount;
+    static constexpr std::array<std::array<std::uint16_t, N>, UnitCount> Units = []
+    {
+      std::array<std::array<std::uint16_t, N>, UnitCount> units{};
+      for (size_t k = 0U; k < N; ++k)
+      {
+        for (size_t l = 0U; l < N; ++l)
+        {
+          units[k][l] = static_cast<std::uint16_t>(k * N + l);
+          units[N + k][l] = static_cast<std::uint16_t>(l * N + k);
+          if constexpr (B != 0U)
+          {
+            units[2U * N + k][l] = static_cast<std::uint16_t>(((k / B) * B + (l / B)) * N + (k % B) * B + (l % B));
+          }
+        }
+      }
+      return units;
+    }();
+
+    // Voisines de chaque case : sa ligne, sa colonne et le reste de son bloc
+    static constexpr size_t PeerCount = 2U * (N - 1U) + ((B == 0U) ? 0U : (B - 1U) * (B - 1U));
+    static constexpr std::array<std::array<std::uint16_t, PeerCount>, Size> Peers = []
+    {
+      std::array<std::array<std::uint16_t, PeerCount>, Size> peers{};
+      for (size_t cell = 0U; cell < Size; ++cell)
+      {
+        size_t count = 0U;
+        for (size_t other = 0U; other < Size; ++other)
+        {
+          const bool row = (Cells[other].Row == Cells[cell].Row);
+          const bool column = (Cells[other].Column == Cells[cell].Column);
+          const bool box = (B != 0U) && (Cells[other].Box == Cells[cell].Box);
+          if ((other != cell) && (row || column || box))
+          {
+            peers[cell][count++] = static_cast<std::uint16_t>(other);
+          }
+        }
+      }
+      return peers;
+    }();
+
+    static constexpr size_t
+    index(const tda::Coord &coord)
+    {
+      return coord.X * N + coord.Y;
+    }
+
+    static constexpr mask_t
+    bit(const size_t value)
+    {
+      return static_cast<mask_t>(mask_t{1U} << (value - 1U));
+    }
+
+    static constexpr bool
+    single(const mask_t mask)
+    {
+      return (mask & (mask - 1U)) == 0U;
+    }
+
+    // Valeurs déjà placées dans une unité
+    static mask_t
+    placed(const state_t &state, const size_t unit)
+    {
+      if (unit < N)
+      {
+        return state.Rows[unit];
+      }
+      else if (unit < 2U * N)
+      {
+        return state.Columns[unit - N];
+      }
+      else
+      {
+        return state.Boxes[unit - 2U * N];
+      }
+    }
+
+    // Valeurs déjà placées dans la ligne, la colonne et le bloc d'une case
+    static mask_t
+    taken(const state_t &state, const size_t cell)
+    {
+      const cell_t &position = Cells[cell];
+      mask_t mask = static_cast<mask_t>(state.Rows[position.Row] | state.Columns[position.Column]);
+      if constexpr (B != 0U)
+      {
+        mask |= state.Boxes[position.Box];
+      }
+      return mask;
+    }
+
+    // Candidats d'une case, ou sa valeur si elle est placée
+    static mask_t
+    domain(const state_t &state, const size_t cell)
+    {
+      return (state.Values[cell] != 0U) ? bit(state.Values[cell]) : state.Candidates[cell];
+    }
+
+    // Inscrit une valeur dans sa case et dans les masques de ses unités
+    static void
+    fix(state_t &state, const size_t cell, const mask_t value)
+    {
+      const cell_t &position = Cells[cell];
+      state.Values[cell] = static_cast<std::uint8_t>(std::countr_zero(value) + 1);
+      state.Candidates[cell] = 0U;
+      state.Rows[position.Row] |= value;
+      state.Columns[position.Column] |= value;
+      if constexpr (B != 0U)
+      {
+        state.Boxes[position.Box] |= value;
+      }
+      --state.Empty;
+    }
+
+    // Place une valeur et la retire des voisines, retourne false si une voisine n'a plus de candidat
+    static bool
+    place(state_t &state, const size_t cell, const mask_t value, pending_t &pending)
+    {
+      fix(state, cell, value);
+      // sans branchement : une voisine devient vide ou singleton seulement si elle perd la valeur
+      bool wiped = false;
+      for (const std::uint16_t peer : Peers[cell])
+      {
+        const mask_t before = state.Candidates[peer];
+        const mask_t after = static_cast<mask_t>(before & ~value);
+        state.Candidates[peer] = after;
+        const bool lost = (after != before);
+        wiped |= lost & (after == 0U);
+        pending.Cells[pending.Count] = peer;
+        pending.Count += static_cast<size_t>(lost & (after != 0U) & single(after));
+      }
+      return !wiped;
+    }
+
+    // Restreint les candidats d'une case (ou vérifie sa valeur), retourne false si le masque devient vide
+    static bool
+    restrict(state_t &state, const size_t cell, const mask_t mask, pending_t &pending, bool &changed)
+    {
+      if (state.Values[cell] != 0U)
+      {
+        return (bit(state.Values[cell]) & mask) != 0U;
+      }
+      const mask_t before = state.Candidates[cell];
+      const mask_t after = static_cast<mask_t>(before & mask);
+      if (after != before)
+      {
+        state.Candidates[cell] = after;
+        changed = true;
+        if ((after != 0U) && single(after))
+        {
+          pending.Cells[pending.Count++] = static_cast<std::uint16_t>(cell);
+        }
+      }
+      return after != 0U;
+    }
+
+    // Propagation jusqu'au point fixe, retourne false en cas d'échec
+    bool
+    propagate(state_t &state, pending_t &pending) const
+    {
+      for (;;)
+      {
+        // Singletons : une case n'ayant qu'un candidat
+        while (pending.Count > 0U)
+        {
+          const size_t cell = pending.Cells[--pending.Count];
+          if (state.Values[cell] == 0U)
+          {
+            const mask_t d = state.Candidates[cell];
+            if ((d == 0U) || !place(state, cell, d, pending))
+            {
+              return false;
+            }
+          }
+        }
+        // une grille complète n'a plus que ses inégalités à vérifier
+        if (state.Empty > 0U)
+        {
+          // Singletons cachés : une valeur manquante n'ayant qu'une case possible dans son unité
+          bool placedHidden = false;
+          for (size_t u = 0U; u < UnitCount; ++u)
+          {
+            const std::array<std::uint16_t, N> &unit = Units[u];
+            mask_t once = 0U;
+            mask_t twice = 0U;
+            for (const std::uint16_t cell : unit)
+            {
+              const mask_t d = state.Candidates[cell];
+              twice |= static_cast<mask_t>(once & d);
+              once |= d;
+            }
+            const mask_t missing = static_cast<mask_t>(Full & ~placed(state, u));
+            if ((once & missing) != missing)
+            {
+              return false;
+            }
+            mask_t hidden = static_cast<mask_t>(once & ~twice);
+            placedHidden |= (hidden != 0U);
+            for (size_t k = 0U; (k < N) && (hidden != 0U); ++k)
+            {
+              const mask_t d = static_cast<mask_t>(state.Candidates[unit[k]] & hidden);
+              if (d != 0U)
+              {
+                if (!single(d) || !place(state, unit[k], d, pending))
+                {
+                  // deux valeurs ne pouvant aller que dans cette case, ou une voisine sans candidat
+                  return false;
+                }
+                hidden &= static_cast<mask_t>(~d);
+              }
+            }
+          }
+          if (placedHidden)
+          {
+            continue;
+          }
+        }
+        // Inégalités : inf est inférieur au maximum de sup, sup est supérieur au minimum de inf
+        bool changed = false;
+        for (const inferior_t &inferior : Inferiors)
+        {
+          const mask_t inf = domain(state, inferior.Inf);
+          const mask_t sup = domain(state, inferior.Sup);
+          if ((inf == 0U) || (sup == 0U))
+          {
+            return false;
+          }
+          const mask_t below = static_cast<mask_t>(std::bit_floor(sup) - 1U);
+          const mask_t lowest = static_cast<mask_t>(inf & (~inf + 1U));
+          const mask_t above = static_cast<mask_t>(~(lowest | (lowest - 1U)));
+          if (!restrict(state, inferior.Inf, below, pending, changed) || !restrict(state, inferior.Sup, above, pending, changed))
+          {
+            return false;
+          }
+        }
+        if (!changed)
+        {
+          return true;
+        }
+      }
+    }
+
+    // Case non placée ayant le moins de candidats
+    static size_t
+    choose(const state_t &state)
+    {
+      size_t best = Size;
+      int bestCount = static_cast<int>(N) + 1;
+      for (size_t cell = 0U; cell < Size; ++cell)
+      {
+        const int count = std::popcount(state.Candidates[cell]);
+        if ((count > 0) && (count < bestCount))
+        {
+          best = cell;
+          bestCount = count;
+          if (count <= 2)
+          {
+            break;
+          }
+        }
+      }
+      return best;
+    }
+
+    template <class VisitT>
+    void
+    start(VisitT &&visit)
+    {
+      Nodes = 0U;
+      if (Consistent)
+      {
+        // les valeurs imposées sont retirées des candidats de leurs unités en un seul balayage
+        state_t state = Root;
+        pending_t pending;
+        bool wiped = false;
+        for (size_t cell = 0U; cell < Size; ++cell)
+        {
+          const mask_t d = static_cast<mask_t>(state.Candidates[cell] & ~taken(state, cell));
+          state.Candidates[cell] = d;
+          wiped |= (state.Values[cell] == 0U) & (d == 0U);
+          pending.Cells[pending.Count] = static_cast<std::uint16_t>(cell);
+          pending.Count += static_cast<size_t>((d != 0U) & single(d));
+        }
+        if (!wiped)
+        {
+          search(state, pending, visit);
+        }
+      }
+    }
+
+    // Recherche en profondeur par copie de l'état (quelques centaines d'octets) :
+    // visit(solution) retourne true pour arrêter la recherche
+    template <class VisitT>
+    bool
+    search(state_t &state, pending_t &pending, VisitT &visit)
+    {
+      if (!propagate(state, pending))
+      {
+        return false;
+      }
+      if (state.Empty == 0U)
+      {
+        return visit(state);
+      }
+      const size_t cell = choose(state);
+      mask_t d = state.Candidates[cell];
+      ++Nodes;
+      while (d != 0U)
+      {
+        const mask_t value = static_cast<mask_t>(d & (~d + 1U));
+        d &= static_cast<mask_t>(d - 1U);
+        state_t child = state;
+        pending_t next;
+        if (place(child, cell, value, next) && search(child, next, visit))
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    state_t Root;
+    state_t Solution;
+    std::vector<inferior_t> Inferiors;
+    bool Consistent = true;
+    size_t Nodes = 0U;
+  };
+}
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef LEVEL_SET_H
+#define LEVEL_SET_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace solver
+{
+
+  // Ensemble de niveaux de décision (1 pour le premier point de choix, 0 pour la racine qui n'est jamais mémorisée).
+  // Sert d'explication : les niveaux dont dépend une exclusion ou un échec.
+  class LevelSet
+  {
+  public:
+    void insert(const size_t level)
+    {
+      const size_t word = level / Width;
+      if (word >= Words.size())
+      {
+        Words.resize(word + 1U, 0U);
+      }
+      Words[word] |= (std::uint64_t{1U} << (level % Width));
+    }
+
+    void merge(const LevelSet &levels)
+    {
+      if (levels.Words.size() > Words.size())
+      {
+        Words.resize(levels.Words.size(), 0U);
+      }
+      for (size_t w = 0U; w < levels.Words.size(); ++w)
+      {
+        Words[w] |= levels.Words[w];
+      }
+    }
+
+    // Ajoute les niveaux [1, level]
+    void fill(const size_t level)
+    {
+      for (size_t l = 1U; l <= level; ++l)
+      {
+        insert(l);
+      }
+    }
+
+    // Ne conserve que les niveaux strictement inférieurs à level
+    void truncate(const size_t level)
+    {
+      const size_t word = level / Width;
+      if (word < Words.size())
+      {
+        Words[word] &= ((std::uint64_t{1U} << (level % Width)) - 1U);
+        Words.resize(word + 1U);
+      }
+    }
+
+    void clear()
+    {
+      Words.clear();
+    }
+
+    bool empty() const
+    {
+      return std::all_of(Words.begin(), Words.end(), [](const std::uint64_t word)
+                         { return word == 0U; });
+    }
+
+    size_t size() const
+    {
+      size_t count = 0U;
+      for (const std::uint64_t word : Words)
+      {
+        count += static_cast<size_t>(std::popcount(word));
+      }
+      return count;
+    }
+
+    // Plus grand niveau de l'ensemble (0 si l'ensemble est vide)
+    size_t max() const
+    {
+      for (size_t w = Words.size(); w > 0U; --w)
+      {
+        if (Words[w - 1U] != 0U)
+        {
+          return (w - 1U) * Width + (Width - 1U - static_cast<size_t>(std::countl_zero(Words[w - 1U])));
+        }
+      }
+      return 0U;
+    }
+
+    bool contains(const size_t level) const
+    {
+      const size_t word = level / Width;
+      return (word < Words.size()) && (((Words[word] >> (level % Width)) & 1U) != 0U);
+    }
+
+  private:
+    static constexpr size_t Width = 64U;
+
+    std::vector<std::uint64_t> Words;
+  };
+}
+
+#endif
@@ -0,0 +1,474 @@
+#ifndef PUZZLE_CORPUS_H
+#define PUZZLE_CORPUS_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "carre.h"
+#include "gridLoader.h"
+
+namespace solver
+{
+
+  // Corpus binaire de grilles N x N (N <= 15) : un en-tête de 32 octets suivi d'enregistrements de taille fixe,
+  // l'enregistrement i commence donc à CorpusHeaderSize + i * taille (l'index est implicite).
+  // En-tête, entiers petit-boutistes :
+  //   0  "ALGOGRID"   8  version (u32)   12  nature (u32)   16  N (u32)   20  taille d'un enregistrement (u32)
+  //   24 nombre d'enregistrements (u64)
+  // Enregistrement :
+  //   - N x N cases de 4 bits, ligne par ligne, la case paire dans les bits de poids faible (0 : case vide)
+  //   - futoshiki : relations de 2 bits entre cases voisines, les N x (N-1) relations horizontales (i, j)-(i, j+1)
+  //     puis les (N-1) x N relations verticales (i, j)-(i+1, j)
+  //   - solution : un octet d'état après les cases
+  enum class CorpusKind : std::uint32_t
+  {
+    Sudoku = 1U,
+    Futoshiki = 2U,
+    Solution = 3U
+  };
+
+  // Relation entre une case et sa voisine de droite ou du dessous
+  enum class Relation : std::uint8_t
+  {
+    None = 0U,
+    Less = 1U,   // la case est inférieure à sa voisine
+    Greater = 2U // la case est supérieure à sa voisine
+  };
+
+  enum class SolutionStatus : std::uint8_t
+  {
+    Solved = 0U,
+    Unsatisfiable = 1U,
+    Invalid = 2U
+  };
+
+  constexpr std::array<char, 8U> CorpusMagic = {'A', 'L', 'G', 'O', 'G', 'R', 'I', 'D'};
+  constexpr std::uint32_t CorpusVersion = 1U;
+  constexpr size_t CorpusHeaderSize = 32U;
+  constexpr size_t CorpusMaxSize = 15U;
+
+  constexpr size_t
+  cellBytes(const size_t n)
+  {
+    return ((n * n) + 1U) / 2U;
+  }
+
+  constexpr size_t
+  relationBytes(const size_t n)
+  {
+    return ((4U * n * (n - 1U)) + 7U) / 8U;
+  }
+
+  constexpr size_t
+  recordSize(const CorpusKind kind, const size_t n)
+  {
+    switch (kind)
+    {
+    case CorpusKind::Futoshiki:
+      return cellBytes(n) + relationBytes(n);
+    case CorpusKind::Solution:
+      return cellBytes(n) + 1U;
+    default:
+      return cellBytes(n);
+    }
+  }
+
+  // Vue en lecture seule sur un enregistrement, sans copie
+  class GridView
+  {
+  public:
+    GridView(const std::uint8_t *data, const size_t size)
+        : Data(data), Size(size)
+    {
+    }
+
+    size_t
+    size() const
+    {
+      return Size;
+    }
+
+    // Valeur d'une case, 0 si elle est vide
+    size_t
+    value(const tda::Coord &coord) const
+    {
+      const size_t cell = (coord.X * Size) + coord.Y;
+      return (Data[cell / 2U] >> ((cell % 2U) * 4U)) & 0x0FU;
+    }
+
+    // Relation entre (i, j) et (i, j+1)
+    Relation
+    right(const tda::Coord &coord) const
+    {
+      return relation((coord.X * (Size - 1U)) + coord.Y);
+    }
+
+    // Relation entre (i, j) et (i+1, j)
+    Relation
+    down(const tda::Coord &coord) const
+    {
+      return relation((Size * (Size - 1U)) + (coord.X * Size) + coord.Y);
+    }
+
+    SolutionStatus
+    status() const
+    {
+      return static_cast<SolutionStatus>(Data[cellBytes(Size)]);
+    }
+
+  private:
+    Relation
+    relation(const size_t index) const
+    {
+      return static_cast<Relation>((Data[cellBytes(Size) + (index / 4U)] >> ((index % 4U) * 2U)) & 0x03U);
+    }
+
+    const std::uint8_t *Data;
+    size_t Size;
+  };
+
+  // Enregistrement en construction (conversion depuis le texte, solution à écrire)
+  class GridRecord
+  {
+  public:
+    GridRecord(const CorpusKind kind, const size_t size)
+        : Bytes(recordSize(kind, size), 0U), Size(size)
+    {
+    }
+
+    void
+    setValue(const tda::Coord &coord, const size_t value)
+    {
+      const size_t cell = (coord.X * Size) + coord.Y;
+      const unsigned shift = (cell % 2U) * 4U;
+      Bytes[cell / 2U] = static_cast<std::uint8_t>((Bytes[cell / 2U] & ~(0x0FU << shift)) | ((value & 0x0FU) << shift));
+    }
+
+    void
+    setRight(const tda::Coord &coord, const Relation relation)
+    {
+      setRelation((coord.X * (Size - 1U)) + coord.Y, relation);
+    }
+
+    void
+    setDown(const tda::Coord &coord, const Relation relation)
+    {
+      setRelation((Size * (Size - 1U)) + (coord.X * Size) + coord.Y, relation);
+    }
+
+    void
+    setStatus(const SolutionStatus status)
+    {
+      Bytes[cellBytes(Size)] = static_cast<std::uint8_t>(status);
+    }
+
+    GridView
+    view() const
+    {
+      return GridView(Bytes.data(), Size);
+    }
+
+    const std::vector<std::uint8_t> &
+    bytes() const
+    {
+      return Bytes;
+    }
+
+  private:
+    void
+    setRelation(const size_t index, const Relation relation)
+    {
+      const size_t byte = cellBytes(Size) + (index / 4U);
+      const unsigned shift = (index % 4U) * 2U;
+      Bytes[byte] = static_cast<std::uint8_t>((Bytes[byte] & ~(0x03U << shift)) | (static_cast<unsigned>(relation) << shift));
+    }
+
+    std::vector<std::uint8_t> Bytes;
+    size_t Size;
+  };
+
+  // Enregistrement d'une solution : value(coord) pour une grille résolue
+  template <class FctT>
+  GridRecord
+  solutionRecord(const size_t size, const SolutionStatus status, FctT &&value)
+  {
+    GridRecord record(CorpusKind::Solution, size);
+    record.setStatus(status);
+    for (size_t i = 0U; (i < size) && (status == SolutionStatus::Solved); ++i)
+    {
+      for (size_t j = 0U; j < size; ++j)
+      {
+        record.setValue({i, j}, value(tda::Coord{i, j}));
+      }
+    }
+    return record;
+  }
+
+  // Solution sur une ligne de N x N cases (cellChar), "unsatisfiable" ou "invalid" (format du traitement par lots texte)
+  inline std::string
+  formatSolution(const GridView &view)
+  {
+    switch (view.status())
+    {
+    case SolutionStatus::Solved:
+      break;
+    case SolutionStatus::Unsatisfiable:
+      return "unsatisfiable";
+    default:
+      return "invalid";
+    }
+    std::string solution(view.size() * view.size(), '0');
+    for (size_t k = 0U; k < solution.size(); ++k)
+    {
+      solution[k] = cellChar(view.value(tda::Coord{k / view.size(), k % view.size()}));
+    }
+    return solution;
+  }
+
+  namespace corpus_detail
+  {
+    inline std::uint64_t
+    load(const std::uint8_t *data, const size_t bytes)
+    {
+      std::uint64_t value = 0U;
+      for (size_t b = bytes; b > 0U; --b)
+      {
+        value = (value << 8U) | data[b - 1U];
+      }
+      return value;
+    }
+
+    inline void
+    store(std::uint8_t *data, std::uint64_t value, const size_t bytes)
+    {
+      for (size_t b = 0U; b < bytes; ++b)
+      {
+        data[b] = static_cast<std::uint8_t>(value & 0xFFU);
+        value >>= 8U;
+      }
+    }
+  }
+
+  // Vrai si le fichier commence par l'en-tête d'un corpus binaire
+  inline bool
+  isCorpusFile(const std::string &path)
+  {
+    std::array<char, CorpusMagic.size()> magic{};
+    std::ifstream input(path, std::ios::binary);
+    return input.read(magic.data(), magic.size()) && (magic == CorpusMagic);
+  }
+
+  // Corpus binaire projeté en mémoire : les vues pointent directement dans la projection
+  class MappedCorpus
+  {
+  public:
+    MappedCorpus() = default;
+    MappedCorpus(const MappedCorpus &) = delete;
+    MappedCorpus &operator=(const MappedCorpus &) = delete;
+
+    MappedCorpus(MappedCorpus &&other) noexcept
+    {
+      *this = std::move(other);
+    }
+
+    MappedCorpus &
+    operator=(MappedCorpus &&other) noexcept
+    {
+      if (this != &other)
+      {
+        close();
+        std::swap(Data, other.Data);
+        std::swap(Length, other.Length);
+        std::swap(Kind, other.Kind);
+        std::swap(Size, other.Size);
+        std::swap(RecordSize, other.RecordSize);
+        std::swap(Count, other.Count);
+      }
+      return *this;
+    }
+
+    ~MappedCorpus()
+    {
+      close();
+    }
+
+    // Projette le fichier, retourne false s'il n'est pas un corpus valide
+    bool
+    open(const std::string &path)
+    {
+      close();
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+      {
+        return false;
+      }
+      struct stat info{};
+      if ((::fstat(fd, &info) == 0) && (static_cast<size_t>(info.st_size) >= CorpusHeaderSize))
+      {
+        void *data = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+          Data = static_cast<const std::uint8_t *>(data);
+          Length = static_cast<size_t>(info.st_size);
+          // lecture séquentielle par le traitement par lots
+          ::madvise(data, Length, MADV_SEQUENTIAL);
+        }
+      }
+      ::close(fd);
+      if ((Data == nullptr) || !readHeader())
+      {
+        close();
+        return false;
+      }
+      return true;
+    }
+
+    void
+    close()
+    {
+      if (Data != nullptr)
+      {
+        ::munmap(const_cast<std::uint8_t *>(Data), Length);
+      }
+      Data = nullptr;
+      Length = 0U;
+      Count = 0U;
+    }
+
+    CorpusKind
+    kind() const
+    {
+      return Kind;
+    }
+
+    // Taille N des grilles
+    size_t
+    size() const
+    {
+      return Size;
+    }
+
+    // Nombre d'enregistrements
+    size_t
+    count() const
+    {
+      return Count;
+    }
+
+    GridView
+    operator[](const size_t index) const
+    {
+      return GridView(Data + CorpusHeaderSize + (index * RecordSize), Size);
+    }
+
+  private:
+    bool
+    readHeader()
+    {
+      using corpus_detail::load;
+      Kind = static_cast<CorpusKind>(load(Data + 12U, 4U));
+      Size = static_cast<size_t>(load(Data + 16U, 4U));
+      RecordSize = static_cast<size_t>(load(Data + 20U, 4U));
+      Count = static_cast<size_t>(load(Data + 24U, 8U));
+      const bool known = (Kind == CorpusKind::Sudoku) || (Kind == CorpusKind::Futoshiki) || (Kind == CorpusKind::Solution);
+      return (std::memcmp(Data, CorpusMagic.data(), CorpusMagic.size()) == 0) &&
+             (load(Data + 8U, 4U) == CorpusVersion) && known &&
+             (Size > 0U) && (Size <= CorpusMaxSize) && (RecordSize == recordSize(Kind, Size)) &&
+             (Count <= (Length - CorpusHeaderSize) / RecordSize);
+    }
+
+    const std::uint8_t *Data = nullptr;
+    size_t Length = 0U;
+    CorpusKind Kind = CorpusKind::Sudoku;
+    size_t Size = 0U;
+    size_t RecordSize = 0U;
+    size_t Count = 0U;
+  };
+
+  // Ecriture d'un corpus binaire : le nombre d'enregistrements de l'en-tête est mis à jour à la fermeture
+  class CorpusWriter
+  {
+  public:
+    CorpusWriter() = default;
+    CorpusWriter(const CorpusWriter &) = delete;
+    CorpusWriter &operator=(const CorpusWriter &) = delete;
+
+    ~CorpusWriter()
+    {
+      close();
+    }
+
+    bool
+    open(const std::string &path, const CorpusKind kind, const size_t size)
+    {
+      close();
+      Kind = kind;
+      Size = size;
+      Count = 0U;
+      if ((size > 0U) && (size <= CorpusMaxSize))
+      {
+        Output.open(path, std::ios::binary | std::ios::trunc);
+        writeHeader();
+      }
+      return Output.good();
+    }
+
+    // Ajoute un enregistrement de la nature et de la taille du corpus, retourne false s'il n'en est pas
+    bool
+    write(const GridRecord &record)
+    {
+      const std::vector<std::uint8_t> &bytes = record.bytes();
+      if (!Output.is_open() || (bytes.size() != recordSize(Kind, Size)))
+      {
+        return false;
+      }
+      Output.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+      ++Count;
+      return Output.good();
+    }
+
+    bool
+    close()
+    {
+      bool good = true;
+      if (Output.is_open())
+      {
+        Output.seekp(0);
+        writeHeader();
+        good = Output.good();
+        Output.close();
+      }
+      return good;
+    }
+
+  private:
+    void
+    writeHeader()
+    {
+      using corpus_detail::store;
+      std::array<std::uint8_t, CorpusHeaderSize> header{};
+      std::memcpy(header.data(), CorpusMagic.data(), CorpusMagic.size());
+      store(header.data() + 8U, CorpusVersion, 4U);
+      store(header.data() + 12U, static_cast<std::uint32_t>(Kind), 4U);
+      store(header.data() + 16U, Size, 4U);
+      store(header.data() + 20U, recordSize(Kind, Size), 4U);
+      store(header.data() + 24U, Count, 8U);
+      Output.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size()));
+    }
+
+    std::ofstream Output;
+    CorpusKind Kind = CorpusKind::Sudoku;
+    size_t Size = 0U;
+    size_t Count = 0U;
+  };
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef RECORD_STACK_H
+#define RECORD_STACK_H
+
+#include <algorithm>
+#include <vector>
+
+namespace solver
+{
+
+  // Pile de points de choix dont les enregistrements dépilés restent en réserve :
+  // un enregistrement réempilé réutilise la mémoire de ses tampons (copies du contexte en mode Copy).
+  template <class RecordT>
+  class RecordStack
+  {
+  public:
+    using iterator = typename std::vector<RecordT>::iterator;
+    using const_iterator = typename std::vector<RecordT>::const_iterator;
+
+    // Empile un enregistrement réservé, ou construit par make() si la réserve est vide.
+    // Un enregistrement réservé conserve ses anciennes valeurs : l'appelant les redéfinit toutes.
+    template <class FctT>
+    RecordT &
+    push(FctT &&make)
+    {
+      if (Size == Records.size())
+      {
+        Records.push_back(make());
+      }
+      return Records[Size++];
+    }
+
+    void
+    pop_back()
+    {
+      --Size;
+    }
+
+    RecordT &
+    back()
+    {
+      return Records[Size - 1U];
+    }
+
+    const RecordT &
+    back() const
+    {
+      return Records[Size - 1U];
+    }
+
+    // Ne conserve que les size premiers enregistrements
+    void
+    truncate(const size_t size)
+    {
+      Size = std::min(Size, size);
+    }
+
+    void
+    clear()
+    {
+      Size = 0U;
+    }
+
+    size_t
+    size() const
+    {
+      return Size;
+    }
+
+    bool
+    empty() const
+    {
+      return (Size == 0U);
+    }
+
+    iterator
+    begin()
+    {
+      return Records.begin();
+    }
+
+    iterator
+    end()
+    {
+      return Records.begin() + static_cast<std::ptrdiff_t>(Size);
+    }
+
+    const_iterator
+    begin() const
+    {
+      return Records.begin();
+    }
+
+    const_iterator
+    end() const
+    {
+      return Records.begin() + static_cast<std::ptrdiff_t>(Size);
+    }
+
+  private:
+    std::vector<RecordT> Records;
+    size_t Size = 0U;
+  };
+}
+
+#endif
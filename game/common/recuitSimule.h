@@ -20,6 +20,15 @@ namespace solver
       computeInitialTemperature();
     }
 
+    // Tirages reproductibles : même graine, même suite de voisins
+    RecuitSimule(const Problem& p, const std::default_random_engine::result_type seed) : Generator(seed), Best(p) {
+      computeInitialTemperature();
+    }
+
+    double temperature() const {
+      return Temperature;
+    }
+
     Problem start() {
       std::uniform_real_distribution<double> uniform_dist(0.0, 1.0);
       Problem current = Best;
@@ -85,7 +94,6 @@ namespace solver
       }
       averageDelta = averageDelta / static_cast<double>(SamplesCount);
       Temperature = -averageDelta / std::log(INITIAL_PROBABILITY);
-      std::cout << "Temperature " << Temperature << std::endl;
     }
   };
 }
@@ -0,0 +1,134 @@
+#ifndef SOLVER_STATISTICS_H
+#define SOLVER_STATISTICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+// Statistiques du solveur, choisies à la compilation :
+// - SOLVER_STATISTICS=0 supprime les compteurs (échecs, retours arrière, exclusions, compteurs par contrainte)
+// - SOLVER_PROFILING=1 ajoute la mesure du temps passé dans chaque contrainte
+#ifndef SOLVER_STATISTICS
+#define SOLVER_STATISTICS 1
+#endif
+
+#ifndef SOLVER_PROFILING
+#define SOLVER_PROFILING 0
+#endif
+
+namespace solver
+{
+  constexpr bool StatisticsEnabled = (SOLVER_STATISTICS != 0);
+  constexpr bool ProfilingEnabled = StatisticsEnabled && (SOLVER_PROFILING != 0);
+
+  // Compteur à écrivain unique : seul le fil de la recherche l'incrémente (sans instruction atomique coûteuse),
+  // un autre fil peut le lire pendant la recherche.
+  class Counter
+  {
+  public:
+    Counter() = default;
+
+    Counter(const Counter &counter)
+        : Value(counter.get())
+    {
+    }
+
+    Counter &operator=(const Counter &counter)
+    {
+      Value.store(counter.get(), std::memory_order_relaxed);
+      return *this;
+    }
+
+    Counter &operator+=(const size_t value)
+    {
+      Value.store(get() + value, std::memory_order_relaxed);
+      return *this;
+    }
+
+    Counter &operator++()
+    {
+      return (*this += 1U);
+    }
+
+    // Conserve la plus grande valeur observée
+    void raise(const size_t value)
+    {
+      if (value > get())
+      {
+        Value.store(value, std::memory_order_relaxed);
+      }
+    }
+
+    size_t get() const
+    {
+      return Value.load(std::memory_order_relaxed);
+    }
+
+    operator size_t() const
+    {
+      return get();
+    }
+
+  private:
+    std::atomic<size_t> Value{0U};
+  };
+
+  struct ConstraintStatistics
+  {
+    // Appels, échecs et valeurs exclues par la contrainte
+    size_t Calls = 0U;
+    size_t Failures = 0U;
+    size_t Exclusions = 0U;
+    // Temps passé dans la contrainte (SOLVER_PROFILING)
+    std::chrono::nanoseconds Time = std::chrono::nanoseconds::zero();
+  };
+
+  struct SolverStatistics
+  {
+    size_t Nodes = 0U;
+    size_t Failures = 0U;
+    size_t Backtracks = 0U;
+    size_t Propagations = 0U;
+    size_t Exclusions = 0U;
+    size_t Solutions = 0U;
+    // Plus grand nombre de points de choix mémorisés simultanément
+    size_t PeakBackup = 0U;
+    // Points de choix sautés par le retour arrière dirigé par les conflits et nogoods appris
+    size_t Backjumps = 0U;
+    size_t Nogoods = 0U;
+    size_t Restarts = 0U;
+    size_t MemoryPerNode = 0U;
+    std::vector<ConstraintStatistics> Constraints;
+
+    void writeJson(std::ostream &os) const
+    {
+      os << "{\"nodes\":" << Nodes
+         << ",\"failures\":" << Failures
+         << ",\"backtracks\":" << Backtracks
+         << ",\"propagations\":" << Propagations
+         << ",\"exclusions\":" << Exclusions
+         << ",\"solutions\":" << Solutions
+         << ",\"peakBackup\":" << PeakBackup
+         << ",\"backjumps\":" << Backjumps
+         << ",\"nogoods\":" << Nogoods
+         << ",\"restarts\":" << Restarts
+         << ",\"memoryPerNode\":" << MemoryPerNode
+         << ",\"constraints\":[";
+      for (size_t c = 0U; c < Constraints.size(); ++c)
+      {
+        const ConstraintStatistics &constraint = Constraints[c];
+        os << ((c == 0U) ? "" : ",")
+           << "{\"id\":" << c
+           << ",\"calls\":" << constraint.Calls
+           << ",\"failures\":" << constraint.Failures
+           << ",\"exclusions\":" << constraint.Exclusions
+           << ",\"timeNs\":" << constraint.Time.count() << "}";
+      }
+      os << "]}";
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,336 @@
+#ifndef VARIABLE_STORE_H
+#define VARIABLE_STORE_H
+
+#include <concepts>
+#include <functional>
+#include <algorithm>
+#include <map>
+#include <memory_resource>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace solver
+{
+
+  // Un indexeur associe à chaque indice une position unique dans [0, size()[.
+  // Une position hors de cet intervalle signifie que l'indice n'est pas adressable.
+  template <class I, class IndiceT>
+  concept indexer = std::default_initializable<I> and
+    requires(const I i, const IndiceT indice)
+    {
+      { i(indice) } -> std::convertible_to<size_t>;
+      { i.size() } -> std::convertible_to<size_t>;
+    };
+
+  template <class T>
+  concept hashable = requires(const T t)
+    {
+      { std::hash<T>{}(t) } -> std::convertible_to<size_t>;
+    };
+
+  // Les magasins de variables garantissent la stabilité des adresses des variables
+  // (les références sont conservées par le solveur pendant la recherche).
+  // Ils réutilisent leur mémoire d'une instance à l'autre : après clear(), les insertions suivantes
+  // n'allouent plus rien une fois atteinte la taille des instances précédentes.
+
+  // Magasin dense : les variables sont rangées dans un tableau contigu à la position donnée par l'indexeur.
+  template <class VariableT, indexer<typename VariableT::indice_t> IndexerT>
+  class DenseStore
+  {
+  public:
+    using variable_t = VariableT;
+    using indice_t = typename VariableT::indice_t;
+
+    DenseStore()
+        : Slots(Indexer.size()), Used(Indexer.size(), false)
+    {
+    }
+
+    variable_t *
+    find(const indice_t &indice)
+    {
+      const size_t position = Indexer(indice);
+      if ((position < Slots.size()) && Used[position] && (Slots[position]->indice() == indice))
+      {
+        return &(*Slots[position]);
+      }
+      return nullptr;
+    }
+
+    const variable_t *
+    find(const indice_t &indice) const
+    {
+      return const_cast<DenseStore *>(this)->find(indice);
+    }
+
+    bool
+    insert(const variable_t &var)
+    {
+      const size_t position = Indexer(var.indice());
+      const bool success = (position < Slots.size()) && !Used[position];
+      if (success)
+      {
+        // Un emplacement libéré conserve sa variable : l'affectation réutilise sa mémoire
+        if (Slots[position].has_value())
+        {
+          *Slots[position] = var;
+        }
+        else
+        {
+          Slots[position].emplace(var);
+        }
+        Used[position] = true;
+        ++Count;
+      }
+      return success;
+    }
+
+    void
+    erase(const indice_t &indice)
+    {
+      if (find(indice) != nullptr)
+      {
+        Used[Indexer(indice)] = false;
+        --Count;
+      }
+    }
+
+    void
+    clear()
+    {
+      std::fill(Used.begin(), Used.end(), false);
+      Count = 0U;
+    }
+
+    size_t
+    size() const
+    {
+      return Count;
+    }
+
+    template <class FctT>
+    void
+    forEach(FctT &&fct)
+    {
+      for (size_t position = 0U; position < Slots.size(); ++position)
+      {
+        if (Used[position])
+        {
+          fct(*Slots[position]);
+        }
+      }
+    }
+
+  private:
+    IndexerT Indexer;
+    std::vector<std::optional<variable_t>> Slots;
+    std::vector<bool> Used;
+    size_t Count = 0U;
+  };
+
+  // Magasin haché : pour les indices non denses.
+  // Les noeuds sont alloués dans un pool propre au magasin, les variables supprimées y sont recyclées.
+  template <class VariableT>
+    requires hashable<typename VariableT::indice_t>
+  class HashStore
+  {
+  public:
+    using variable_t = VariableT;
+    using indice_t = typename VariableT::indice_t;
+
+    HashStore()
+        : Variables(&Memory)
+    {
+    }
+
+    HashStore(const HashStore &store)
+        : Variables(store.Variables, &Memory)
+    {
+    }
+
+    HashStore(HashStore &&store)
+        : Variables(std::move(store.Variables), &Memory)
+    {
+    }
+
+    // Les affectations conservent le pool de destination
+    HashStore &operator=(const HashStore &store)
+    {
+      Variables = store.Variables;
+      return *this;
+    }
+
+    HashStore &operator=(HashStore &&store)
+    {
+      Variables = std::move(store.Variables);
+      return *this;
+    }
+
+    variable_t *
+    find(const indice_t &indice)
+    {
+      auto &&it = Variables.find(indice);
+      return (it != Variables.end()) ? &(it->second) : nullptr;
+    }
+
+    const variable_t *
+    find(const indice_t &indice) const
+    {
+      auto &&it = Variables.find(indice);
+      return (it != Variables.cend()) ? &(it->second) : nullptr;
+    }
+
+    bool
+    insert(const variable_t &var)
+    {
+      return Variables.insert(std::make_pair(var.indice(), var)).second;
+    }
+
+    void
+    erase(const indice_t &indice)
+    {
+      Variables.erase(indice);
+    }
+
+    void
+    clear()
+    {
+      Variables.clear();
+    }
+
+    size_t
+    size() const
+    {
+      return Variables.size();
+    }
+
+    template <class FctT>
+    void
+    forEach(FctT &&fct)
+    {
+      for (auto &&var : Variables)
+      {
+        fct(var.second);
+      }
+    }
+
+  private:
+    std::pmr::unsynchronized_pool_resource Memory;
+    std::pmr::unordered_map<indice_t, variable_t> Variables;
+  };
+
+  // Magasin ordonné : pour les indices ni denses ni hachables (noeuds alloués dans le pool du magasin)
+  template <class VariableT>
+  class OrderedStore
+  {
+  public:
+    using variable_t = VariableT;
+    using indice_t = typename VariableT::indice_t;
+
+    OrderedStore()
+        : Variables(&Memory)
+    {
+    }
+
+    OrderedStore(const OrderedStore &store)
+        : Variables(store.Variables, &Memory)
+    {
+    }
+
+    OrderedStore(OrderedStore &&store)
+        : Variables(std::move(store.Variables), &Memory)
+    {
+    }
+
+    OrderedStore &operator=(const OrderedStore &store)
+    {
+      Variables = store.Variables;
+      return *this;
+    }
+
+    OrderedStore &operator=(OrderedStore &&store)
+    {
+      Variables = std::move(store.Variables);
+      return *this;
+    }
+
+    variable_t *
+    find(const indice_t &indice)
+    {
+      auto &&it = Variables.find(indice);
+      return (it != Variables.end()) ? &(it->second) : nullptr;
+    }
+
+    const variable_t *
+    find(const indice_t &indice) const
+    {
+      auto &&it = Variables.find(indice);
+      return (it != Variables.cend()) ? &(it->second) : nullptr;
+    }
+
+    bool
+    insert(const variable_t &var)
+    {
+      return Variables.insert(std::make_pair(var.indice(), var)).second;
+    }
+
+    void
+    erase(const indice_t &indice)
+    {
+      Variables.erase(indice);
+    }
+
+    void
+    clear()
+    {
+      Variables.clear();
+    }
+
+    size_t
+    size() const
+    {
+      return Variables.size();
+    }
+
+    template <class FctT>
+    void
+    forEach(FctT &&fct)
+    {
+      for (auto &&var : Variables)
+      {
+        fct(var.second);
+      }
+    }
+
+  private:
+    std::pmr::unsynchronized_pool_resource Memory;
+    std::pmr::map<indice_t, variable_t> Variables;
+  };
+
+  // Sélection du magasin : dense si un indexeur est fourni, haché sinon, ordonné en dernier recours
+  template <class VariableT, class IndexerT>
+  struct store_selector
+  {
+    using type = DenseStore<VariableT, IndexerT>;
+  };
+
+  template <class VariableT>
+  struct store_selector<VariableT, void>
+  {
+    using type = OrderedStore<VariableT>;
+  };
+
+  template <class VariableT>
+    requires hashable<typename VariableT::indice_t>
+  struct store_selector<VariableT, void>
+  {
+    using type = HashStore<VariableT>;
+  };
+
+  template <class VariableT, class IndexerT>
+  using variable_store_t = typename store_selector<VariableT, IndexerT>::type;
+}
+
+#endif
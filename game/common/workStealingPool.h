@@ -0,0 +1,144 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace solver
+{
+
+  // Réserve de tâches à vol de travail : chaque fil d'exécution possède sa propre file.
+  // - un fil dépile ses propres tâches par la fin (la plus récente, parcours en profondeur)
+  // - un fil inoccupé vole les tâches des autres par le début (la plus ancienne, le plus grand sous-arbre)
+  // La réserve est terminée lorsque toutes les tâches déposées ont été traitées.
+  template <class JobT>
+  class WorkStealingPool
+  {
+  public:
+    explicit WorkStealingPool(const size_t workers)
+        : Queues(workers)
+    {
+    }
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    size_t
+    workers() const
+    {
+      return Queues.size();
+    }
+
+    void
+    push(const size_t worker, JobT job)
+    {
+      ++Pending;
+      ++Queued;
+      std::lock_guard<std::mutex> lock(Queues[worker].Mutex);
+      Queues[worker].Jobs.push_back(std::move(job));
+    }
+
+    std::optional<JobT>
+    pop(const size_t worker)
+    {
+      std::optional<JobT> job = popBack(worker);
+      for (size_t k = 1U; (k < Queues.size()) && !job.has_value(); ++k)
+      {
+        job = popFront((worker + k) % Queues.size());
+      }
+      return job;
+    }
+
+    // Signale la fin du traitement d'une tâche obtenue par pop()
+    void
+    done()
+    {
+      --Pending;
+    }
+
+    bool
+    finished() const
+    {
+      return (Pending == 0U);
+    }
+
+    // Un fil est inoccupé tant qu'il ne trouve aucune tâche
+    void
+    setIdle(const bool idle)
+    {
+      if (idle)
+      {
+        ++Idle;
+      }
+      else
+      {
+        --Idle;
+      }
+    }
+
+    // Vrai si des fils inoccupés attendent plus de tâches qu'il n'y en a en réserve
+    bool
+    hungry() const
+    {
+      return (Idle > Queued);
+    }
+
+    void
+    stop()
+    {
+      Stopped = true;
+    }
+
+    bool
+    stopped() const
+    {
+      return Stopped;
+    }
+
+  private:
+    struct queue_t
+    {
+      std::mutex Mutex;
+      std::deque<JobT> Jobs;
+    };
+
+    std::optional<JobT>
+    popBack(const size_t worker)
+    {
+      std::optional<JobT> job;
+      std::lock_guard<std::mutex> lock(Queues[worker].Mutex);
+      if (!Queues[worker].Jobs.empty())
+      {
+        job = std::move(Queues[worker].Jobs.back());
+        Queues[worker].Jobs.pop_back();
+        --Queued;
+      }
+      return job;
+    }
+
+    std::optional<JobT>
+    popFront(const size_t worker)
+    {
+      std::optional<JobT> job;
+      std::lock_guard<std::mutex> lock(Queues[worker].Mutex);
+      if (!Queues[worker].Jobs.empty())
+      {
+        job = std::move(Queues[worker].Jobs.front());
+        Queues[worker].Jobs.pop_front();
+        --Queued;
+      }
+      return job;
+    }
+
+    std::vector<queue_t> Queues;
+    std::atomic<size_t> Pending{0U};
+    std::atomic<size_t> Queued{0U};
+    std::atomic<size_t> Idle{0U};
+    std::atomic<bool> Stopped{false};
+  };
+}
+
+#endif
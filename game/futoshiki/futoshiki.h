@@ -3,7 +3,13 @@
 #define FUTOSHIKI_H
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <numeric>
 #include <optional>
+#include <span>
 #include <vector>
 #include "carre.h"
 
@@ -52,6 +58,125 @@ namespace tda {
     Direction Side = Direction::Up;
   };
 
+  // Graphe des inégalités au format CSR (compressed sparse row), indexé par le rang X * N + Y des cases :
+  // cases supérieures (successeurs) et inférieures (prédécesseurs) de chaque case rangées dans des tableaux contigus,
+  // construits une fois pour toutes depuis les inégalités lues.
+  template<size_t N>
+  class InequalityGraph {
+  public:
+    using cell_t = std::uint16_t;
+    static constexpr size_t CellCount = N * N;
+    static_assert(CellCount <= std::numeric_limits<cell_t>::max());
+
+    InequalityGraph() {
+      SuccessorOffsets.fill(0U);
+      PredecessorOffsets.fill(0U);
+    }
+
+    // Les inégalités viennent de grilles lues dans des fichiers : celles dont une case sort de la grille N x N
+    // sont rejetées avant la construction (valid() retourne alors false), comme toutes les inégalités
+    // si leur nombre dépasse la capacité des index
+    explicit InequalityGraph(const std::vector<InferiorConstraint>& constraints) {
+      SuccessorOffsets.fill(0U);
+      PredecessorOffsets.fill(0U);
+      const size_t accepted = static_cast<size_t>(std::count_if(constraints.begin(), constraints.end(), inside));
+      Valid = (accepted == constraints.size());
+      if (accepted > std::numeric_limits<cell_t>::max()) {
+        return;
+      }
+      // tri par dénombrement : les inégalités d'une même case gardent leur ordre de lecture
+      std::array<cell_t, CellCount + 1U> successorCounts{};
+      std::array<cell_t, CellCount + 1U> predecessorCounts{};
+      for (const InferiorConstraint& c : constraints) {
+        if (inside(c)) {
+          ++successorCounts[index(c.Inf()) + 1U];
+          ++predecessorCounts[index(c.Sup()) + 1U];
+        }
+      }
+      std::partial_sum(successorCounts.begin(), successorCounts.end(), SuccessorOffsets.begin());
+      std::partial_sum(predecessorCounts.begin(), predecessorCounts.end(), PredecessorOffsets.begin());
+      Successors.resize(accepted);
+      Sources.resize(accepted);
+      Predecessors.resize(accepted);
+      std::array<cell_t, CellCount> successorNext{};
+      std::array<cell_t, CellCount> predecessorNext{};
+      std::copy_n(SuccessorOffsets.begin(), CellCount, successorNext.begin());
+      std::copy_n(PredecessorOffsets.begin(), CellCount, predecessorNext.begin());
+      for (const InferiorConstraint& c : constraints) {
+        if (!inside(c)) {
+          continue;
+        }
+        const size_t inf = index(c.Inf());
+        const size_t sup = index(c.Sup());
+        Sources[successorNext[inf]] = static_cast<cell_t>(inf);
+        Successors[successorNext[inf]++] = static_cast<cell_t>(sup);
+        Predecessors[predecessorNext[sup]++] = static_cast<cell_t>(inf);
+      }
+    }
+
+    // Faux si une inégalité reçue a été rejetée
+    bool valid() const noexcept {
+      return Valid;
+    }
+
+    static constexpr size_t index(const Coord c) noexcept {
+      return (c.X * N) + c.Y;
+    }
+
+    static constexpr Coord coord(const size_t cell) noexcept {
+      return Coord{cell / N, cell % N};
+    }
+
+    // Cases strictement supérieures à la case
+    std::span<const cell_t> successors(const size_t cell) const noexcept {
+      return {Successors.data() + SuccessorOffsets[cell], Successors.data() + SuccessorOffsets[cell + 1U]};
+    }
+
+    // Cases strictement inférieures à la case
+    std::span<const cell_t> predecessors(const size_t cell) const noexcept {
+      return {Predecessors.data() + PredecessorOffsets[cell], Predecessors.data() + PredecessorOffsets[cell + 1U]};
+    }
+
+    // Nombre d'inégalités
+    size_t size() const noexcept {
+      return Successors.size();
+    }
+
+    // Appelle fct(inf, sup) pour chaque inégalité, dans l'ordre des cases inférieures
+    template<class FctT>
+    void forEach(FctT&& fct) const {
+      for (size_t cell = 0U; cell < CellCount; ++cell) {
+        for (const cell_t sup : successors(cell)) {
+          fct(cell, static_cast<size_t>(sup));
+        }
+      }
+    }
+
+    // Nombre d'inégalités non respectées par values (une valeur par case, rangée X * N + Y) :
+    // boucle sans branchement sur les inégalités à plat, case inférieure (Sources) et supérieure (Successors)
+    template<class ValueT>
+    size_t countViolations(const std::array<ValueT, CellCount>& values) const noexcept {
+      size_t violations = 0U;
+      for (size_t k = 0U; k < Successors.size(); ++k) {
+        violations += static_cast<size_t>(values[Sources[k]] >= values[Successors[k]]);
+      }
+      return violations;
+    }
+
+  private:
+    // Les deux cases de l'inégalité sont dans la grille (une coordonnée passée sous 0 devient très grande)
+    static bool inside(const InferiorConstraint& c) noexcept {
+      return (c.Inf().X < N) && (c.Inf().Y < N) && (c.Sup().X < N) && (c.Sup().Y < N);
+    }
+
+    std::array<cell_t, CellCount + 1U> SuccessorOffsets;
+    std::array<cell_t, CellCount + 1U> PredecessorOffsets;
+    std::vector<cell_t> Successors;
+    std::vector<cell_t> Sources;        // case inférieure de chaque entrée de Successors
+    std::vector<cell_t> Predecessors;
+    bool Valid = true;
+  };
+
   struct Assertion {
     Coord Pos;
     size_t Value;
@@ -104,10 +229,12 @@ namespace tda {
 
   template<size_t N>
   class Futoshiki {
+    static_assert(N <= 64U, "Futoshiki values are packed in 64-bit masks");
+
   public:
     Futoshiki(const std::vector<InferiorConstraint>& constaints,
               const std::vector<Assertion>& inits) 
-    : Constraints(constaints) {
+    : Inequalities(constaints) {
 
       std::array<size_t,N> range;
       std::iota(range.begin(), range.end(), 1U);
@@ -117,6 +244,7 @@ namespace tda {
       for(auto i: inits) {
         Grid[i.Pos.X][i.Pos.Y].Values = {i.Value};
         Grid[i.Pos.X][i.Pos.Y].Selected = i.Value;
+        Cells[InequalityGraph<N>::index(i.Pos)] = static_cast<std::uint8_t>(i.Value);
         values[i.Pos.X][i.Value - 1U] = 0U;
       }
 
@@ -126,7 +254,9 @@ namespace tda {
         std::remove(values[i].begin(), values[i].end(), 0U);
         for(size_t j = 0U; j < N; ++j) {
           if (!Grid[i][j].isSet()) {
-            Grid[i][j].Selected = values[i][k++];
+            Grid[i][j].Selected = values[i][k];
+            Cells[InequalityGraph<N>::index({i, j})] = static_cast<std::uint8_t>(values[i][k]);
+            ++k;
             Index.push_back({i, j});
           }
         }
@@ -135,6 +265,7 @@ namespace tda {
 
     void setValue(const Assertion assert) {
       Grid[assert.Pos.X][assert.Pos.Y].Selected = assert.Value;
+      Cells[InequalityGraph<N>::index(assert.Pos)] = static_cast<std::uint8_t>(assert.Value);
     }
 
     const std::vector<size_t>& getValueSelection(const Coord c) const {
@@ -149,37 +280,23 @@ namespace tda {
       return *(Grid[c.X][c.Y].Selected);
     }
 
+    // Doublons des lignes et des colonnes (chaque case a une valeur : N cases moins le nombre de valeurs présentes,
+    // compté par popcount sur les masques de valeurs) et inégalités non respectées
     size_t getViolationsCount() const {
-      size_t violations = 0U;
-      std::array<std::array<bool, N>, N> lines;
-      std::array<bool, N> occurences;
-      occurences.fill(false);
-      lines.fill(occurences);
-      std::array<std::array<bool, N>, N> columns(lines);
-      
+      std::array<std::uint64_t, N> lines{};
+      std::array<std::uint64_t, N> columns{};
       for(size_t i = 0U; i < N; ++i) {
         for(size_t j = 0U; j < N; ++j) {
-          const size_t value = *(Grid[i][j].Selected) - 1U;
-          if (lines[i][value]) {
-            ++violations;
-          }
-          else {
-            lines[i][value] = true;
-          }
-          if (columns[j][value]) {
-            ++violations;
-          }
-          else {
-            columns[j][value] = true;
-          }
-        }  
-      }
-      for (const InferiorConstraint& c : Constraints) {
-        if (Grid[c.Inf().X][c.Inf().Y].Selected >= Grid[c.Sup().X][c.Sup().Y].Selected) {
-          ++violations;
+          const std::uint64_t bit = std::uint64_t{1U} << (Cells[(i * N) + j] - 1U);
+          lines[i] |= bit;
+          columns[j] |= bit;
         }
       }
-      return violations;
+      size_t present = 0U;
+      for(size_t k = 0U; k < N; ++k) {
+        present += static_cast<size_t>(std::popcount(lines[k]) + std::popcount(columns[k]));
+      }
+      return (2U * N * N) - present + Inequalities.countViolations(Cells);
     }
 
     constexpr static size_t GetSize() noexcept {
@@ -188,8 +305,10 @@ namespace tda {
 
   private:
     std::vector<Coord> Index;
-    std::vector<InferiorConstraint> Constraints;
+    InequalityGraph<N> Inequalities;
     std::array<std::array<PotentialValues<N>, N>, N> Grid;
+    // Valeur choisie de chaque case, rangée X * N + Y (évaluation des violations)
+    std::array<std::uint8_t, N * N> Cells{};
 
     template<size_t X>
     friend std::ostream& operator<<(std::ostream& os, const Futoshiki<X>& f);
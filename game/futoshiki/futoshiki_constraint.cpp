@@ -9,144 +9,304 @@
  */
 
 // clang-tidy futoshiki_constraint.cpp -checks=cppcoreguidelines-* -- -std=c++20
-// clang++-11 -std=c++20 futoshiki/futoshiki_constraint.cpp -o futoshikiBin -Icommon -Ifutoshiki
+// clang++-11 -std=c++20 futoshiki/futoshiki_constraint.cpp -o futoshikiBin -Icommon -Ifutoshiki -pthread
+// Traitement par lots : futoshikiBin corpus.txt [threads] [solutions.txt] [bitboard|generic], '-' pour l'entrée standard
+// (une grille par ligne : les 2N-1 lignes de la grille texte concaténées, soit 289 caractères en 9 x 9 ;
+// les tailles se mélangent, de 4 à 16 par des noyaux instanciés à la compilation, les autres par le modèle dynamique)
+// Corpus binaire (puzzleCorpus.h) : futoshikiBin --convert corpus.txt corpus.bin, puis
+// futoshikiBin corpus.bin [threads] [solutions.bin] [bitboard|generic] ; futoshikiBin --convert solutions.bin solutions.txt
 
 #include <iostream>
 #include <chrono>
 #include <array>
-#include "futoshiki.h"
-#include "constraintSolver.h"
-#include "dependencyGraph.h"
+#include <thread>
+#include <optional>
+#include <fstream>
+#include <string>
+#include "batchPipeline.h"
+#include "futoshiki_model.h"
 
-using solver_constraint_t = solver::ConstraintSolver<size_t, tda::Coord>;
+using namespace futoshiki;
 
-template<class T>
-size_t max_bound(solver_constraint_t& solver, const tda::Coord& c, T first, T last)
+constexpr std::size_t SquareSize = 9U;
+constexpr std::size_t Repetitions = 20U;
+
+using solver_static_t = static_solver_t<SquareSize>;
+using solver_latin_t = solver::LatinSquare<SquareSize>;
+
+// Mesure la durée moyenne de résolution pour une politique de domaine
+template<class SolverT, size_t N>
+bool benchmark(const char* name, const model_t<N>& model, SolverT& algoC, const options_t& options)
 {
-  std::vector<std::size_t> column;
-  std::vector<std::size_t> line;
-  for (;first != last; ++first) 
-  {
-    const tda::Coord& sup = first->second.Sup();
-    const size_t val = (*solver.get(sup).domain().rbegin());
-    if (c.X == sup.X)
-    {
-      line.push_back(val);
-    }
-    else
-    {
-      column.push_back(val);
-    }
-  }
-  const auto [minEL, maxEL] = std::minmax_element(line.begin(), line.end());
-  const auto [minEC, maxEC] = std::minmax_element(column.begin(), column.end());
-  if (!line.empty() && !column.empty())
+  bool result = false;
+  std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+  for (size_t r = 0U; r < Repetitions; ++r)
   {
-    return std::min({(*minEL) - 1U, (*maxEL) - line.size(), (*minEC) - 1U, (*maxEC) - column.size()});
+    algoC = SolverT{};
+    configure(algoC, options);
+    result = setup(algoC, model, options);
+    std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
+    result = result && algoC.solve();
+    duration += std::chrono::steady_clock::now() - start;
   }
-  else if (!line.empty())
+  std::cout << "Duration[" << name << "]=" << std::chrono::duration_cast<std::chrono::microseconds>(duration).count() / Repetitions << "us"
+            << " MemoryPerNode=" << algoC.memoryPerNode() << "B nodes=" << algoC.choicePoints()
+            << " propagations=" << algoC.propagations() << std::endl;
+  return result;
+}
+
+// Mesure la durée moyenne de résolution du moteur spécialisé
+template<size_t N>
+bool benchmark(const char* name, const model_t<N>& model, solver::LatinSquare<N>& algoL)
+{
+  bool result = false;
+  std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+  for (size_t r = 0U; r < Repetitions; ++r)
   {
-    return std::min((*minEL) - 1U, (*maxEL) - line.size());
+    result = setup(algoL, model);
+    std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
+    result = result && algoL.solve();
+    duration += std::chrono::steady_clock::now() - start;
   }
-  else if (!column.empty())
+  std::cout << "Duration[" << name << "]=" << std::chrono::duration_cast<std::chrono::microseconds>(duration).count() / Repetitions << "us"
+            << " nodes=" << algoL.choicePoints() << std::endl;
+  return result;
+}
+
+// Solution d'une grille texte n x n d'une autre taille par le modèle dynamique
+std::string solveDynamic(const std::vector<std::string>& rows, const size_t n)
+{
+  const std::optional<dynamic_puzzle_t> puzzle = parseDynamic(rows, n);
+  if (!puzzle.has_value())
   {
-    return std::min((*minEC) - 1U, (*maxEC) - column.size());
+    return "invalid";
   }
-  else
+  dynamic_solver_t algoC;
+  algoC.setBacktrackMode(solver::BacktrackMode::Trail);
+  if (!setupDynamic(algoC, *puzzle) || !algoC.solve())
   {
-    return 0U;
+    return "unsatisfiable";
   }
+  return format(n, [&algoC](const tda::Coord& c) { return algoC.get(c).value(); });
 }
 
-template<class T>
-size_t min_bound(solver_constraint_t& solver, const tda::Coord& c, T first, T last)
+// Solution d'une grille texte N x N par un noyau instancié à la compilation : moteur spécialisé (bitboard),
+// ou solveur générique aux domaines en bitset pour la taille usuelle (instancier le solveur générique
+// pour chaque taille multiplierait la durée de compilation), le modèle dynamique sinon
+template<size_t N>
+std::string solveGrid(const std::vector<std::string>& rows, const bool generic)
 {
-  std::vector<std::size_t> column;
-  std::vector<std::size_t> line;
-  for (;first != last; ++first) 
+  if ((N != SquareSize) && generic)
   {
-    const tda::Coord& inf = first->second.Inf();
-    const size_t val = (*solver.get(inf).domain().begin());
-    if (c.X == inf.X)
-    {
-      line.push_back(val);
-    }
-    else
-    {
-      column.push_back(val);
-    }
+    return solveDynamic(rows, N);
+  }
+  const std::optional<puzzle_t<N>> puzzle = parse<N>(rows);
+  if (!puzzle.has_value())
+  {
+    return "invalid";
   }
-  const auto [minEL, maxEL] = std::minmax_element(line.begin(), line.end());
-  const auto [minEC, maxEC] = std::minmax_element(column.begin(), column.end());
-  if (!line.empty() && !column.empty())
+  if constexpr (N == SquareSize)
   {
-    return std::max({(*maxEL) + 1U, (*minEL) + line.size(), (*maxEC) + 1U, (*minEC) + column.size()});
+    if (generic)
+    {
+      solver_static_t algoC;
+      algoC.setBacktrackMode(solver::BacktrackMode::Trail);
+      if (!setup(algoC, puzzle->model(), {}) || !algoC.solve())
+      {
+        return "unsatisfiable";
+      }
+      return format<N>([&algoC](const tda::Coord& c) { return algoC.get(c).value(); });
+    }
   }
-  else if (!line.empty())
+  solver::LatinSquare<N> algoL;
+  if (!setup(algoL, puzzle->model()) || !algoL.solve())
   {
-    return std::max((*maxEL) + 1U, (*minEL) + line.size());
+    return "unsatisfiable";
   }
-  else if (!column.empty())
+  return format<N>([&algoL](const tda::Coord& c) { return algoL.value(c); });
+}
+
+// Résolution d'un corpus texte (fichier ou entrée standard) par le moteur spécialisé (bitboard) ou par le solveur générique.
+// La taille de chaque grille est déduite de sa longueur, les inégalités dépendent de la grille :
+// le solveur est construit pour chaque problème.
+// Chaque ligne de sortie est la solution (N x N cases), "unsatisfiable" ou "invalid".
+int batch(const char* corpus, const size_t threads, const char* solutions, const bool generic)
+{
+  solver::GridInput input;
+  if (!input.open(corpus))
   {
-    return std::max((*maxEC) + 1U, (*minEC) + column.size());
+    std::cerr << "cannot open " << corpus << std::endl;
+    return 1;
   }
-  else
+  std::ofstream file;
+  if (solutions != nullptr)
   {
-    return 0U;
+    file.open(solutions);
   }
+  std::ostream& output = (solutions != nullptr) ? file : std::cout;
+  const solver::BatchReport report = solver::runBatch(input.stream(), output, threads,
+    []()
+    {
+      return std::vector<std::string>{};
+    },
+    [generic](std::vector<std::string>& rows, const std::string& line)
+    {
+      const std::optional<size_t> n = squareSize(line.size());
+      if (!n.has_value())
+      {
+        return std::string("invalid");
+      }
+      splitRows(line, *n, rows);
+      std::string solution;
+      const bool kernel = solver::dispatchSize<solver::KernelMinSize, solver::KernelMaxSize>(*n, [&](const auto size)
+      {
+        solution = solveGrid<decltype(size)::value>(rows, generic);
+      } );
+      return kernel ? solution : solveDynamic(rows, *n);
+    });
+  report.write(std::cerr);
+  std::cerr << std::endl;
+  return 0;
 }
 
-bool inequal(solver_constraint_t& solver, const std::vector<tda::Coord>& constraintsOrder, 
-  const std::multimap<tda::Coord,tda::InferiorConstraint>& constraintsInfMap,
-  const std::multimap<tda::Coord,tda::InferiorConstraint>& constraintsSupMap)
+// Résolution d'un corpus binaire projeté en mémoire : le moteur spécialisé lit les grilles dans la projection,
+// le solveur générique reconstruit les inégalités de chaque enregistrement.
+// Les solutions sont écrites dans un corpus binaire de solutions, ou en texte sur la sortie standard.
+int batch(const solver::MappedCorpus& grids, const size_t threads, const char* solutions, const bool generic)
 {
-  bool sastified = true;
-  for (auto it = constraintsOrder.begin(); it != constraintsOrder.end(); ++it)
+  if ((grids.kind() != solver::CorpusKind::Futoshiki) || (grids.size() != SquareSize))
+  {
+    std::cerr << "not a futoshiki " << SquareSize << "x" << SquareSize << " corpus" << std::endl;
+    return 1;
+  }
+  solver::CorpusWriter writer;
+  if ((solutions != nullptr) && !writer.open(solutions, solver::CorpusKind::Solution, SquareSize))
   {
-    const typename solver_constraint_t::variable_t var = solver.get(*it);
-    if (!var.isInstantiated() && !var.isCompromised())
+    std::cerr << "cannot open " << solutions << std::endl;
+    return 1;
+  }
+  const solver::BatchReport report = solver::runBatch(grids,
+    [&writer, solutions](solver::GridRecord&& record)
     {
-      auto&& range = constraintsInfMap.equal_range(*it);
-      if (range.first != range.second)
+      if (solutions != nullptr)
       {
-        const size_t newmax = max_bound(solver, *it, range.first, range.second);
-        const size_t oldmax = (*var.domain().rbegin());
-        for (size_t k = newmax + 1U; (k <= oldmax) && sastified; ++k)
-        {
-          sastified = solver.exclude(k, *it);
-        }
-        if (!sastified) 
-          break;
+        writer.write(record);
+      }
+      else
+      {
+        std::cout << solver::formatSolution(record.view()) << '\n';
+      }
+    },
+    threads,
+    []()
+    {
+      return solver_latin_t{};
+    },
+    [generic](solver_latin_t& algoL, const solver::GridView& view)
+    {
+      constexpr solver::SolutionStatus Solved = solver::SolutionStatus::Solved;
+      constexpr solver::SolutionStatus Unsatisfiable = solver::SolutionStatus::Unsatisfiable;
+      // enregistrement mal formé ou inégalités en cycle
+      const std::optional<puzzle_t<SquareSize>> puzzle = decode<SquareSize>(view);
+      if (!puzzle.has_value())
+      {
+        return solver::solutionRecord(SquareSize, solver::SolutionStatus::Invalid, [](const tda::Coord&) { return 0U; });
       }
+      if (generic)
+      {
+        solver_static_t algoC;
+        algoC.setBacktrackMode(solver::BacktrackMode::Trail);
+        const bool solved = setup(algoC, puzzle->model(), {}) && algoC.solve();
+        return solver::solutionRecord(SquareSize, solved ? Solved : Unsatisfiable,
+                                      [&algoC](const tda::Coord& c) { return algoC.get(c).value(); });
+      }
+      const bool solved = setup(algoL, puzzle->model()) && algoL.solve();
+      return solver::solutionRecord(SquareSize, solved ? Solved : Unsatisfiable,
+                                    [&algoL](const tda::Coord& c) { return algoL.value(c); });
+    });
+  std::cout.flush();
+  report.write(std::cerr);
+  std::cerr << std::endl;
+  return writer.close() ? 0 : 1;
+}
+
+// Conversion d'un corpus texte en corpus binaire, ou d'un corpus binaire de solutions en texte
+int convert(const char* from, const char* to)
+{
+  constexpr size_t GridSize = (2U * SquareSize) - 1U;
+  if (solver::isCorpusFile(from))
+  {
+    solver::MappedCorpus corpus;
+    std::ofstream output(to);
+    if (!corpus.open(from) || (corpus.kind() != solver::CorpusKind::Solution) || !output)
+    {
+      std::cerr << "cannot convert " << from << std::endl;
+      return 1;
     }
+    for (size_t k = 0U; k < corpus.count(); ++k)
+    {
+      output << solver::formatSolution(corpus[k]) << '\n';
+    }
+    return output.good() ? 0 : 1;
+  }
+  std::ifstream input(from);
+  solver::CorpusWriter writer;
+  if (!input || !writer.open(to, solver::CorpusKind::Futoshiki, SquareSize))
+  {
+    std::cerr << "cannot convert " << from << std::endl;
+    return 1;
   }
-  if (sastified)
+  std::vector<std::string> rows(GridSize);
+  std::string line;
+  for (size_t number = 1U; std::getline(input, line); ++number)
   {
-    for (auto rev = constraintsOrder.rbegin(); rev != constraintsOrder.rend(); ++rev)
+    if (!line.empty() && (line.back() == '\r'))
     {
-      const typename solver_constraint_t::variable_t var = solver.get(*rev);
-      if (!var.isInstantiated() && !var.isCompromised())
-      {
-        auto&& range = constraintsSupMap.equal_range(*rev);
-        if (range.first != range.second)
-        {
-          const size_t newmin = min_bound(solver, *rev, range.first, range.second);
-          const size_t oldmin = (*var.domain().begin());
-          for (size_t k = oldmin; (k < newmin) && sastified; ++k)
-          {
-            sastified = solver.exclude(k, *rev);
-          }
-          if (!sastified) 
-            break;
-        }
-      }
+      line.pop_back();
+    }
+    if (line.empty() || (line.front() == '#'))
+    {
+      continue;
+    }
+    std::optional<puzzle_t<SquareSize>> puzzle;
+    if (line.size() == GridSize * GridSize)
+    {
+      splitRows(line, SquareSize, rows);
+      puzzle = parse<SquareSize>(rows);
+    }
+    if (!puzzle.has_value())
+    {
+      std::cerr << "invalid grid at line " << number << std::endl;
+      return 1;
     }
+    writer.write(encode<SquareSize>(*puzzle));
   }
-  return sastified;
+  return writer.close() ? 0 : 1;
 }
 
-int main() 
+int main(int argc, char* argv[]) 
 {
+  if ((argc > 3) && (std::string(argv[1]) == "--convert"))
+  {
+    return convert(argv[2], argv[3]);
+  }
+  if (argc > 1)
+  {
+    const size_t threads = (argc > 2) ? std::stoul(argv[2]) : std::max(std::thread::hardware_concurrency(), 1U);
+    const bool generic = (argc > 4) && (std::string(argv[4]) == "generic");
+    if (solver::isCorpusFile(argv[1]))
+    {
+      solver::MappedCorpus grids;
+      if (!grids.open(argv[1]))
+      {
+        std::cerr << "invalid corpus " << argv[1] << std::endl;
+        return 1;
+      }
+      return batch(grids, threads, (argc > 3) ? argv[3] : nullptr, generic);
+    }
+    return batch(argv[1], threads, (argc > 3) ? argv[3] : nullptr, generic);
+  }
+
   //-> Problème
   const std::string grid[] = {
     "0 0<0 0 0 4 5 7 3",
@@ -171,134 +331,37 @@ int main()
 
   // Init
   constexpr std::size_t GridSize = std::extent_v<decltype(grid)>;
-  constexpr size_t SquareSize = (GridSize / 2U) + 1U;
-  std::array<std::array<size_t,SquareSize>,SquareSize> values;
-  std::vector<tda::InferiorConstraint> constraints;
-  for (size_t i = 0U; i <  GridSize; ++i) 
+  static_assert((GridSize / 2U) + 1U == SquareSize);
+  const std::optional<puzzle_t<SquareSize>> puzzle = parse<SquareSize>({std::begin(grid), std::end(grid)});
+  if (!puzzle.has_value())
   {
-    const std::string& str = grid[i];
-    for (size_t j = 0U; j <  str.size(); ++j)
-    {
-      const char c = str[j];
-      if ('0' <= c && c <= '9') 
-      {
-        values[i/2U][j/2U] = c - '0';
-      }
-      else 
-      {
-        switch (c)
-        {
-        case '<':
-          constraints.push_back(tda::InferiorConstraint({i/2U, j/2U}, tda::Direction::Right));
-          break;
-        case '>':
-          constraints.push_back(tda::InferiorConstraint({i/2U, (j/2U)+1U}, tda::Direction::Left));
-          break;
-        case '^':
-          constraints.push_back(tda::InferiorConstraint({i/2U, j/2U}, tda::Direction::Down));
-          break;
-        case 'v':
-          constraints.push_back(tda::InferiorConstraint({(i/2U)+1U, j/2U}, tda::Direction::Up));
-          break;
-        default:
-          break;
-        }
-      }
-    }
+    std::cerr << "invalid grid" << std::endl;
+    return 1;
   }
 
-  std::multimap<tda::Coord,tda::InferiorConstraint> constraintsInfMap;
-  std::multimap<tda::Coord,tda::InferiorConstraint> constraintsSupMap;
-  for (const tda::InferiorConstraint& constraint : constraints) 
+  // Programmation par contrainte : les autres configurations du solveur générique (politique de domaine,
+  // retour arrière, heuristiques...) sont comparées par le banc d'essai (benchmark/benchmark.cpp)
   {
-    constraintsInfMap.insert(std::make_pair(constraint.Inf(), constraint));
-    constraintsSupMap.insert(std::make_pair(constraint.Sup(), constraint));
-  }
-  DependencyGraph<tda::Coord> depends;
-  for (const tda::InferiorConstraint& constraint : constraints) 
-  {
-    depends.addDependency(constraint.Inf(), constraint.Sup());
-  }
-  std::vector<tda::Coord> constraintsOrder = depends.topologicalSort();
-
-  // Programmation par contrainte
-  {
-    solver_constraint_t algoC;
-
-    algoC.setComparator([](const typename solver_constraint_t::variable_t& variable1,
-                        const typename solver_constraint_t::variable_t& variable2)
-    {
-      return variable1.domainSize() < variable2.domainSize();
-    } );
+    const model_t<SquareSize> model = puzzle->model();
 
-    algoC.setSelector([](const typename solver_constraint_t::variable_t& variable)
-    {
-      return *(variable.domain().begin());
-    } );
-
-    algoC.addConstraint([](solver_constraint_t& solver, const tda::Coord coord, const size_t value)
-    {
-      bool sastified = true;
-      const size_t i = coord.X;
-      const size_t j = coord.Y;
-      // un seul chiffre sur une ligne
-      for (size_t k = 0U; (k < SquareSize) && sastified; ++k)
-      {
-        if (k != j)
-        {
-          sastified = solver.exclude(value, {i, k});
-        }
-      }
-      return sastified;
-    });
-  
-    algoC.addConstraint([](solver_constraint_t& solver, const tda::Coord coord, const size_t value)
-    {
-      bool sastified = true;
-      const size_t i = coord.X;
-      const size_t j = coord.Y;
-      // un seul chiffre sur une colonne
-      for (size_t k = 0U; (k < SquareSize) && sastified; ++k)
-      {
-        if (k != i)
-        {
-          sastified = solver.exclude(value, {k, j});
-        }
-      }
-      return sastified;
-    });
-
-    algoC.addConstraint([&constraintsOrder, &constraintsInfMap, &constraintsSupMap](solver_constraint_t& solver, const tda::Coord coord, const size_t value)
-    {
-      return inequal(solver, constraintsOrder, constraintsInfMap, constraintsSupMap);
-    });
-
-    const auto domain = tda::ValueEnum<SquareSize>;
-    for (size_t i = 0U; i < SquareSize; ++i)
-    {
-      for (size_t j = 0U; j < SquareSize; ++j)
-      {
-        if (values[i][j] == 0U)
-        {
-          algoC.addVariable(domain.begin(), domain.end(), {i, j});
-        }
-        else
-        {
-          algoC.addVariable({values[i][j]}, {i, j});
-        }
-      }
-    }
-    bool result = inequal(algoC, constraintsOrder, constraintsInfMap, constraintsSupMap);
-
-    std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
-    result = result && algoC.solve();
-    std::cout << "Duration=" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() << "ms" << std::endl;
+    constexpr solver::BacktrackMode Trail = solver::BacktrackMode::Trail;
+    solver_static_t algoC;
+    bool result = benchmark("bitset+trail+dense+static", model, algoC, {.Mode = Trail});
     std::cout << "success=" << std::boolalpha << result << std::endl;
+    // Moteur spécialisé : même solution que le solveur générique
+    solver_latin_t algoL;
+    const bool latin = benchmark("bitboard", model, algoL);
+    std::cout << "bitboard=" << ((latin == result) &&
+                                 (format<SquareSize>([&algoL](const tda::Coord& c) { return algoL.value(c); }) ==
+                                  format<SquareSize>([&algoC](const tda::Coord& c) { return algoC.get(c).value(); }))) << std::endl;
+    std::cout << "statistics=";
+    algoC.statistics().writeJson(std::cout);
+    std::cout << std::endl;
     for (size_t i = 0U; i < SquareSize; ++i)
     {
       for (size_t j = 0U; j < SquareSize; ++j)
       {
-        const typename solver_constraint_t::variable_t& variable = algoC.get({i, j});
+        const typename solver_static_t::variable_t& variable = algoC.get({i, j});
         if (variable.isInstantiated())
         {
           std::cout << variable.value();
@@ -31,6 +31,7 @@ int main() {
   };
 
   solver::RecuitSimule<decltype(f), size_t, tda::Coord> algoRS(f);
+  std::cout << "Temperature " << algoRS.temperature() << std::endl;
   
   std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
   auto result = algoRS.start();
@@ -0,0 +1,515 @@
+#ifndef SUDOKU_BANDS_H
+#define SUDOKU_BANDS_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include "carre.h"
+
+namespace sudoku
+{
+  // Moteur spécialisé du sudoku 9 x 9 par bandes : la grille est découpée en trois bandes de trois lignes,
+  // chaque chiffre a un mot de 27 bits par bande (bit 9 * ligne + colonne dans la bande) marquant les cases où il reste
+  // possible, une case résolue ne gardant que le bit de son chiffre. Les lignes et les blocs d'une bande, les colonnes
+  // des trois bandes se lisent par quelques masques constants : un chiffre est placé dans toutes les cases d'une bande
+  // qui l'imposent en une fois (retrait de ses lignes et de ses blocs, de ses colonnes dans les deux autres bandes),
+  // au lieu de mettre à jour les 20 voisines de chaque case une à une comme LatinSquare.
+  // Les singletons d'une bande se lisent sur ses 9 mots ("au moins une fois", "au moins deux fois"), les singletons
+  // cachés sur les lignes, blocs et colonnes des mots d'un chiffre ; la propagation reprend jusqu'au point fixe.
+  // La recherche choisit la case ayant le moins de candidats (la première en cas d'égalité) et essaie les chiffres
+  // par ordre croissant : même point fixe, même choix que LatinSquare<9, 3>, donc même arbre et même première solution.
+  class BandBoard
+  {
+  public:
+    static constexpr size_t Size = 9U;
+
+    BandBoard()
+    {
+      clear();
+    }
+
+    // Grille vide
+    void
+    clear()
+    {
+      for (band_t &band : Root.Bands)
+      {
+        band.fill(Full);
+      }
+      Solution = Root;
+      Consistent = true;
+      Nodes = 0U;
+    }
+
+    // Valeur imposée, retourne false si elle contredit les valeurs déjà imposées
+    bool
+    assign(const tda::Coord &coord, const size_t value)
+    {
+      const size_t index = coord.X / 3U;
+      const std::uint32_t cell = std::uint32_t{1U} << position(coord);
+      if ((value == 0U) || (value > Size) || ((Root.Bands[index][value - 1U] & cell) == 0U))
+      {
+        Consistent = false;
+      }
+      else if ((Root.Bands[index][Unsolved] & cell) != 0U)
+      {
+        place(Root, index, value - 1U, cell);
+      }
+      return Consistent;
+    }
+
+    // Grille complète en une fois : value(coord) donne chaque case (0 si elle est vide),
+    // retourne false si deux chiffres donnés se contredisent ou si une valeur dépasse 9
+    template <class FctT>
+    bool
+    load(FctT &&value)
+    {
+      clear();
+      // cases données de chaque chiffre (rang 0 : cases vides)
+      std::array<std::array<std::uint32_t, Size + 1U>, 3> given{};
+      for (size_t i = 0U; i < Size; ++i)
+      {
+        for (size_t j = 0U; j < Size; ++j)
+        {
+          size_t v = value(tda::Coord{i, j});
+          if (v > Size)
+          {
+            Consistent = false;
+            v = 0U;
+          }
+          given[i / 3U][v] |= std::uint32_t{1U} << position({i, j});
+        }
+      }
+      // chiffre par chiffre sans branche : colonnes occupées, conflits entre chiffres donnés, puis candidats
+      std::array<std::uint32_t, Size> once{};
+      std::array<std::uint32_t, Size> twice{};
+      std::uint32_t clash = 0U;
+      for (size_t index = 0U; index < 3U; ++index)
+      {
+        for (size_t digit = 0U; digit < Size; ++digit)
+        {
+          const std::uint32_t g = given[index][digit + 1U];
+          clash |= clashes(g);
+          fold(g, once[digit], twice[digit]);
+        }
+      }
+      for (size_t index = 0U; index < 3U; ++index)
+      {
+        const std::uint32_t taken = Full & ~given[index][0U];
+        for (size_t digit = 0U; digit < Size; ++digit)
+        {
+          const std::uint32_t g = given[index][digit + 1U];
+          clash |= twice[digit];
+          Root.Bands[index][digit] = (Full & ~(rows(g) | boxes(g) | spread(once[digit]) | taken)) | g;
+        }
+      }
+      Consistent = Consistent && (clash == 0U);
+      for (size_t index = 0U; index < 3U; ++index)
+      {
+        Root.Bands[index][Unsolved] = given[index][0U];
+      }
+      return Consistent;
+    }
+
+    // Recherche la première solution
+    bool
+    solve()
+    {
+      bool found = false;
+      start([this, &found](const state_t &solution)
+      {
+        Solution = solution;
+        found = true;
+        return true;
+      });
+      return found;
+    }
+
+    // Nombre de solutions, limité à limit (0 pour toutes)
+    size_t
+    countSolutions(const size_t limit = 0U)
+    {
+      size_t count = 0U;
+      start([this, &count, limit](const state_t &solution)
+      {
+        if (count == 0U)
+        {
+          Solution = solution;
+        }
+        ++count;
+        return (limit != 0U) && (count >= limit);
+      });
+      return count;
+    }
+
+    // Valeur d'une case de la dernière solution trouvée (0 si aucune)
+    size_t
+    value(const tda::Coord &coord) const
+    {
+      const band_t &band = Solution.Bands[coord.X / 3U];
+      const std::uint32_t cell = std::uint32_t{1U} << position(coord);
+      if ((band[Unsolved] & cell) != 0U)
+      {
+        return 0U;
+      }
+      for (size_t digit = 0U; digit < Size; ++digit)
+      {
+        if ((band[digit] & cell) != 0U)
+        {
+          return digit + 1U;
+        }
+      }
+      return 0U;
+    }
+
+    // Nombre de points de choix de la dernière recherche
+    size_t
+    choicePoints() const
+    {
+      return Nodes;
+    }
+
+  private:
+    // Mots d'une bande : les 9 chiffres puis les cases non résolues
+    static constexpr size_t Unsolved = Size;
+    using band_t = std::array<std::uint32_t, Size + 1U>;
+
+    static constexpr std::uint32_t Full = (std::uint32_t{1U} << 27U) - 1U;
+    static constexpr std::uint32_t Row = 0x1FFU;
+    // colonne 0 des trois lignes d'une bande, bloc 0 d'une bande
+    static constexpr std::uint32_t Column = 0x40201U;
+    static constexpr std::uint32_t Box = 0x1C0E07U;
+
+    struct state_t
+    {
+      std::array<band_t, 3> Bands;
+    };
+
+    static constexpr size_t
+    position(const tda::Coord &coord)
+    {
+      return (coord.X % 3U) * 9U + coord.Y;
+    }
+
+    static constexpr std::uint32_t
+    any(const std::uint32_t mask)
+    {
+      return 0U - static_cast<std::uint32_t>(mask != 0U);
+    }
+
+    static constexpr std::uint32_t
+    several(const std::uint32_t mask)
+    {
+      return any(mask & (mask - 1U));
+    }
+
+    // Lignes, blocs (masques complets) et colonnes (9 bits) contenant au moins une case d'un mot
+    static constexpr std::uint32_t
+    rows(const std::uint32_t cells)
+    {
+      return (any(cells & Row) & Row) | (any(cells & (Row << 9U)) & (Row << 9U)) | (any(cells & (Row << 18U)) & (Row << 18U));
+    }
+
+    static constexpr std::uint32_t
+    boxes(const std::uint32_t cells)
+    {
+      return (any(cells & Box) & Box) | (any(cells & (Box << 3U)) & (Box << 3U)) | (any(cells & (Box << 6U)) & (Box << 6U));
+    }
+
+    static constexpr std::uint32_t
+    columns(const std::uint32_t cells)
+    {
+      return (cells | (cells >> 9U) | (cells >> 18U)) & Row;
+    }
+
+    // Colonnes (9 bits) étendues aux trois lignes d'une bande
+    static constexpr std::uint32_t
+    spread(const std::uint32_t columns)
+    {
+      return columns * Column;
+    }
+
+    // Deux cases d'un mot sur une même ligne ou dans un même bloc : non nul dans ce cas
+    static constexpr std::uint32_t
+    clashes(const std::uint32_t cells)
+    {
+      return several(cells & Row) | several(cells & (Row << 9U)) | several(cells & (Row << 18U)) |
+             several(cells & Box) | several(cells & (Box << 3U)) | several(cells & (Box << 6U));
+    }
+
+    static constexpr bool
+    crowded(const std::uint32_t cells)
+    {
+      return clashes(cells) != 0U;
+    }
+
+    // Colonnes présentes au moins une fois, au moins deux fois parmi les lignes d'un mot
+    static constexpr void
+    fold(const std::uint32_t cells, std::uint32_t &once, std::uint32_t &twice)
+    {
+      for (size_t k = 0U; k < 3U; ++k)
+      {
+        const std::uint32_t row = (cells >> (9U * k)) & Row;
+        twice |= once & row;
+        once |= row;
+      }
+    }
+
+    // Place un chiffre dans des cases non résolues d'une bande n'ayant deux à deux aucune unité commune :
+    // il quitte leurs lignes et leurs blocs, leurs colonnes dans les deux autres bandes, et les autres chiffres
+    // quittent ces cases
+    static void
+    place(state_t &state, const size_t index, const size_t digit, const std::uint32_t cells)
+    {
+      band_t &band = state.Bands[index];
+      for (size_t d = 0U; d < Size; ++d)
+      {
+        band[d] &= ~cells;
+      }
+      band[digit] = (state.Bands[index][digit] & ~(rows(cells) | boxes(cells))) | cells;
+      band[Unsolved] &= ~cells;
+      const std::uint32_t others = ~spread(columns(cells));
+      state.Bands[(index + 1U) % 3U][digit] &= others;
+      state.Bands[(index + 2U) % 3U][digit] &= others;
+    }
+
+    // Singletons d'une bande : chaque chiffre est placé d'un coup dans les cases qui n'ont plus que lui.
+    // Retourne false si une case n'a plus de candidat ou si deux cases d'une unité imposent le même chiffre.
+    static bool
+    singles(state_t &state, const size_t index, bool &placed)
+    {
+      band_t &band = state.Bands[index];
+      std::uint32_t once = 0U;
+      std::uint32_t twice = 0U;
+      for (size_t d = 0U; d < Size; ++d)
+      {
+        twice |= once & band[d];
+        once |= band[d];
+      }
+      if ((band[Unsolved] & ~once) != 0U)
+      {
+        return false;
+      }
+      const std::uint32_t found = band[Unsolved] & ~twice;
+      if (found == 0U)
+      {
+        return true;
+      }
+      // chiffres ayant des cases à placer, parcourus sans tester les autres
+      unsigned digits = 0U;
+      for (size_t d = 0U; d < Size; ++d)
+      {
+        digits |= static_cast<unsigned>((found & band[d]) != 0U) << d;
+      }
+      band_t &next = state.Bands[(index + 1U) % 3U];
+      band_t &last = state.Bands[(index + 2U) % 3U];
+      for (; digits != 0U; digits &= digits - 1U)
+      {
+        const size_t d = static_cast<size_t>(std::countr_zero(digits));
+        const std::uint32_t cells = found & band[d];
+        if ((several(cells) != 0U) && crowded(cells))
+        {
+          return false;
+        }
+        // les autres chiffres ont déjà quitté ces cases
+        band[d] = (band[d] & ~(rows(cells) | boxes(cells))) | cells;
+        const std::uint32_t others = ~spread(columns(cells));
+        next[d] &= others;
+        last[d] &= others;
+      }
+      band[Unsolved] &= ~found;
+      placed = true;
+      return true;
+    }
+
+    // Singletons cachés d'un chiffre : seule case possible d'une ligne, d'un bloc ou d'une colonne où il n'est pas placé.
+    // Retourne false si une unité n'a plus de case pour lui ou si deux cases d'une unité l'imposent.
+    static bool
+    hidden(state_t &state, const size_t digit, bool &placed)
+    {
+      std::array<std::uint32_t, 3> cells{};
+      std::uint32_t once = 0U;
+      std::uint32_t twice = 0U;
+      std::uint32_t solved = 0U;
+      for (size_t index = 0U; index < 3U; ++index)
+      {
+        const band_t &band = state.Bands[index];
+        const std::uint32_t possible = band[digit] & band[Unsolved];
+        const std::uint32_t done = band[digit] & ~band[Unsolved];
+        if ((rows(band[digit]) != Full) || (boxes(band[digit]) != Full))
+        {
+          return false;
+        }
+        std::uint32_t found = 0U;
+        for (size_t k = 0U; k < 3U; ++k)
+        {
+          const std::uint32_t row = possible & (Row << (9U * k));
+          const std::uint32_t box = possible & (Box << (3U * k));
+          found |= row & ~several(row) & ~any(done & (Row << (9U * k)));
+          found |= box & ~several(box) & ~any(done & (Box << (3U * k)));
+        }
+        cells[index] = found;
+        fold(possible, once, twice);
+        solved |= columns(done);
+      }
+      if ((once | solved) != Row)
+      {
+        return false;
+      }
+      const std::uint32_t single = spread(once & ~twice & ~solved);
+      std::uint32_t seen = 0U;
+      for (size_t index = 0U; index < 3U; ++index)
+      {
+        const std::uint32_t found = cells[index] | (state.Bands[index][digit] & state.Bands[index][Unsolved] & single);
+        if (found != 0U)
+        {
+          if (crowded(found) || ((columns(found) & seen) != 0U))
+          {
+            return false;
+          }
+          seen |= columns(found);
+          place(state, index, digit, found);
+          placed = true;
+        }
+      }
+      return true;
+    }
+
+    static bool
+    complete(const state_t &state)
+    {
+      return (state.Bands[0U][Unsolved] | state.Bands[1U][Unsolved] | state.Bands[2U][Unsolved]) == 0U;
+    }
+
+    // Propagation jusqu'au point fixe, retourne false en cas d'échec
+    static bool
+    propagate(state_t &state)
+    {
+      for (;;)
+      {
+        bool placed = false;
+        for (size_t index = 0U; index < 3U; ++index)
+        {
+          if (!singles(state, index, placed))
+          {
+            return false;
+          }
+        }
+        if (placed)
+        {
+          continue;
+        }
+        if (complete(state))
+        {
+          return true;
+        }
+        for (size_t digit = 0U; digit < Size; ++digit)
+        {
+          if (!hidden(state, digit, placed))
+          {
+            return false;
+          }
+        }
+        if (!placed)
+        {
+          return true;
+        }
+      }
+    }
+
+    // Case non résolue ayant le moins de candidats (la première en cas d'égalité) : bande et case
+    static std::pair<size_t, std::uint32_t>
+    choose(const state_t &state)
+    {
+      // au point fixe, chaque case non résolue a au moins deux candidats : la première n'en ayant que deux convient
+      for (size_t index = 0U; index < 3U; ++index)
+      {
+        const band_t &band = state.Bands[index];
+        std::uint32_t once = 0U;
+        std::uint32_t twice = 0U;
+        std::uint32_t thrice = 0U;
+        for (size_t d = 0U; d < Size; ++d)
+        {
+          thrice |= twice & band[d];
+          twice |= once & band[d];
+          once |= band[d];
+        }
+        if (const std::uint32_t pairs = band[Unsolved] & ~thrice; pairs != 0U)
+        {
+          return {index, pairs & (~pairs + 1U)};
+        }
+      }
+      std::pair<size_t, std::uint32_t> best{0U, 0U};
+      int bestCount = static_cast<int>(Size) + 1;
+      for (size_t index = 0U; index < 3U; ++index)
+      {
+        const band_t &band = state.Bands[index];
+        for (std::uint32_t unsolved = band[Unsolved]; unsolved != 0U; unsolved &= unsolved - 1U)
+        {
+          const std::uint32_t cell = unsolved & (~unsolved + 1U);
+          int count = 0;
+          for (size_t d = 0U; d < Size; ++d)
+          {
+            count += static_cast<int>((band[d] & cell) != 0U);
+          }
+          if (count < bestCount)
+          {
+            best = {index, cell};
+            bestCount = count;
+          }
+        }
+      }
+      return best;
+    }
+
+    template <class VisitT>
+    void
+    start(VisitT &&visit)
+    {
+      Nodes = 0U;
+      if (Consistent)
+      {
+        state_t state = Root;
+        search(state, visit);
+      }
+    }
+
+    // Recherche en profondeur par copie de l'état (120 octets) : visit(solution) retourne true pour arrêter la recherche
+    template <class VisitT>
+    bool
+    search(state_t &state, VisitT &visit)
+    {
+      if (!propagate(state))
+      {
+        return false;
+      }
+      if (complete(state))
+      {
+        return visit(state);
+      }
+      const auto [index, cell] = choose(state);
+      ++Nodes;
+      for (size_t digit = 0U; digit < Size; ++digit)
+      {
+        if ((state.Bands[index][digit] & cell) != 0U)
+        {
+          state_t child = state;
+          place(child, index, digit, cell);
+          if (search(child, visit))
+          {
+            return true;
+          }
+        }
+      }
+      return false;
+    }
+
+    state_t Root;
+    state_t Solution;
+    bool Consistent = true;
+    size_t Nodes = 0U;
+  };
+}
+
+#endif
@@ -9,18 +9,331 @@
  */
 
 // clang-tidy sudoku_constraint.cpp -checks=cppcoreguidelines-* -- -std=c++20
-// clang++-11 -std=c++20 sudoku/sudoku_constraint.cpp -o sudokuBin -Icommon
+// clang++-11 -std=c++20 sudoku/sudoku_constraint.cpp -o sudokuBin -Icommon -pthread
+// Traitement par lots : sudokuBin corpus.txt [threads] [solutions.txt] [bitboard|generic], '-' pour l'entrée standard
+// (une grille de N x N caractères par ligne, '0' ou '.' pour une case vide, 'A' pour 10... ; les tailles se mélangent,
+// 4 x 4, 9 x 9 et 16 x 16 par des noyaux instanciés à la compilation, les autres par le modèle dynamique)
+// Corpus binaire (puzzleCorpus.h) : sudokuBin --convert corpus.txt corpus.bin, puis
+// sudokuBin corpus.bin [threads] [solutions.bin] [bitboard|generic] ; sudokuBin --convert solutions.bin solutions.txt
 
 #include <iostream>
 #include <chrono>
 #include <array>
-#include "carre.h"
-#include "constraintSolver.h"
+#include <thread>
+#include <optional>
+#include <fstream>
+#include <string>
+#include "batchPipeline.h"
+#include "sudoku_model.h"
 
-using solver_constraint_t = solver::ConstraintSolver<size_t, tda::Coord>;
+using namespace sudoku;
 
-int main() 
+constexpr std::size_t Repetitions = 100U;
+
+// Carrés des noyaux instanciés à la compilation : grilles de KernelMinSize à KernelMaxSize cases de côté
+constexpr size_t KernelMinBox = 2U;
+constexpr size_t KernelMaxBox = 4U;
+static_assert((KernelMinBox * KernelMinBox >= solver::KernelMinSize) && (KernelMaxBox * KernelMaxBox <= solver::KernelMaxSize));
+
+// Solution d'une grille N x N (carrés B x B) par le moteur spécialisé instancié à la compilation (kernel_t)
+template<size_t B>
+std::string solveGrid(const std::string& line)
+{
+  constexpr size_t N = B * B;
+  const std::optional<square_t<N>> values = parse<N>(line);
+  if (!values.has_value())
+  {
+    return "invalid";
+  }
+  kernel_t<B> algoL;
+  if (!setup(algoL, *values) || !algoL.solve())
+  {
+    return "unsatisfiable";
+  }
+  return format<N>([&algoL](const tda::Coord& c) { return algoL.value(c); });
+}
+
+// Solution d'une grille n x n d'une autre taille par le modèle dynamique
+std::string solveDynamic(const std::string& line, const size_t n)
+{
+  const std::optional<std::vector<size_t>> values = readGrid(line, n);
+  if (!values.has_value())
+  {
+    return "invalid";
+  }
+  dynamic_solver_t algoC;
+  algoC.setBacktrackMode(solver::BacktrackMode::Trail);
+  setupDynamic(algoC, n, *values);
+  if (!algoC.solve())
+  {
+    return "unsatisfiable";
+  }
+  return format(n, [&algoC](const tda::Coord& c) { return algoC.get(c).value(); });
+}
+
+// Résolution d'un corpus texte (fichier ou entrée standard) par le moteur spécialisé (bitboard) ou par le solveur générique,
+// la taille de chaque grille étant déduite de sa longueur. Le solveur générique de la taille usuelle est réutilisé (reset)
+// d'une grille à l'autre par chaque fil, les autres tailles passent par le modèle dynamique.
+// Chaque ligne de sortie est la solution (N x N cases), "unsatisfiable" ou "invalid".
+int batch(const char* corpus, const size_t threads, const char* solutions, const bool generic)
+{
+  solver::GridInput input;
+  if (!input.open(corpus))
+  {
+    std::cerr << "cannot open " << corpus << std::endl;
+    return 1;
+  }
+  std::ofstream file;
+  if (solutions != nullptr)
+  {
+    file.open(solutions);
+  }
+  std::ostream& output = (solutions != nullptr) ? file : std::cout;
+  solver::BatchReport report;
+  if (generic)
+  {
+    report = solver::runBatch(input.stream(), output, threads,
+      []()
+      {
+        solver_static_t algoC;
+        algoC.setBacktrackMode(solver::BacktrackMode::Trail);
+        model(algoC);
+        return algoC;
+      },
+      [](solver_static_t& algoC, const std::string& line)
+      {
+        const std::optional<size_t> n = squareSize(line.size());
+        if (!n.has_value())
+        {
+          return std::string("invalid");
+        }
+        if (*n != SquareSize)
+        {
+          return solveDynamic(line, *n);
+        }
+        const std::optional<grid_t> values = parse(line);
+        if (!values.has_value())
+        {
+          return std::string("invalid");
+        }
+        algoC.reset();
+        load(algoC, *values);
+        if (!algoC.solve())
+        {
+          return std::string("unsatisfiable");
+        }
+        return format([&algoC](const tda::Coord& c) { return algoC.get(c).value(); });
+      });
+  }
+  else
+  {
+    report = solver::runBatch(input.stream(), output, threads,
+      []()
+      {
+        return 0U;
+      },
+      [](unsigned&, const std::string& line)
+      {
+        const std::optional<size_t> n = squareSize(line.size());
+        if (!n.has_value())
+        {
+          return std::string("invalid");
+        }
+        const size_t b = static_cast<size_t>(std::lround(std::sqrt(static_cast<double>(*n))));
+        std::string solution;
+        const bool kernel = solver::dispatchSize<KernelMinBox, KernelMaxBox>(b, [&](const auto box)
+        {
+          solution = solveGrid<decltype(box)::value>(line);
+        } );
+        return kernel ? solution : solveDynamic(line, *n);
+      });
+  }
+  report.write(std::cerr);
+  std::cerr << std::endl;
+  return 0;
+}
+
+// Résolution d'un corpus binaire projeté en mémoire : les solveurs lisent les grilles dans la projection.
+// Les solutions sont écrites dans un corpus binaire de solutions, ou en texte sur la sortie standard.
+int batch(const solver::MappedCorpus& grids, const size_t threads, const char* solutions, const bool generic)
+{
+  if ((grids.kind() != solver::CorpusKind::Sudoku) || (grids.size() != SquareSize))
+  {
+    std::cerr << "not a sudoku corpus" << std::endl;
+    return 1;
+  }
+  solver::CorpusWriter writer;
+  if ((solutions != nullptr) && !writer.open(solutions, solver::CorpusKind::Solution, SquareSize))
+  {
+    std::cerr << "cannot open " << solutions << std::endl;
+    return 1;
+  }
+  const auto write = [&writer, solutions](solver::GridRecord&& record)
+  {
+    if (solutions != nullptr)
+    {
+      writer.write(record);
+    }
+    else
+    {
+      std::cout << solver::formatSolution(record.view()) << '\n';
+    }
+  };
+  solver::BatchReport report;
+  if (generic)
+  {
+    report = solver::runBatch(grids, write, threads,
+      []()
+      {
+        solver_static_t algoC;
+        algoC.setBacktrackMode(solver::BacktrackMode::Trail);
+        model(algoC);
+        return algoC;
+      },
+      [](solver_static_t& algoC, const solver::GridView& view)
+      {
+        algoC.reset();
+        if (!load(algoC, view))
+        {
+          return solver::solutionRecord(SquareSize, solver::SolutionStatus::Invalid, [](const tda::Coord&) { return 0U; });
+        }
+        const bool solved = algoC.solve();
+        return solver::solutionRecord(SquareSize, solved ? solver::SolutionStatus::Solved : solver::SolutionStatus::Unsatisfiable,
+                                      [&algoC](const tda::Coord& c) { return algoC.get(c).value(); });
+      });
+  }
+  else
+  {
+    report = solver::runBatch(grids, write, threads,
+      []()
+      {
+        return solver_bands_t{};
+      },
+      [](solver_bands_t& algoL, const solver::GridView& view)
+      {
+        if (!readable<SquareSize>(view))
+        {
+          return solver::solutionRecord(SquareSize, solver::SolutionStatus::Invalid, [](const tda::Coord&) { return 0U; });
+        }
+        const bool solved = setup(algoL, view) && algoL.solve();
+        return solver::solutionRecord(SquareSize, solved ? solver::SolutionStatus::Solved : solver::SolutionStatus::Unsatisfiable,
+                                      [&algoL](const tda::Coord& c) { return algoL.value(c); });
+      });
+  }
+  std::cout.flush();
+  report.write(std::cerr);
+  std::cerr << std::endl;
+  return writer.close() ? 0 : 1;
+}
+
+// Conversion d'un corpus texte en corpus binaire, ou d'un corpus binaire de solutions en texte
+int convert(const char* from, const char* to)
 {
+  if (solver::isCorpusFile(from))
+  {
+    solver::MappedCorpus corpus;
+    std::ofstream output(to);
+    if (!corpus.open(from) || (corpus.kind() != solver::CorpusKind::Solution) || !output)
+    {
+      std::cerr << "cannot convert " << from << std::endl;
+      return 1;
+    }
+    for (size_t k = 0U; k < corpus.count(); ++k)
+    {
+      output << solver::formatSolution(corpus[k]) << '\n';
+    }
+    return output.good() ? 0 : 1;
+  }
+  std::ifstream input(from);
+  solver::CorpusWriter writer;
+  if (!input || !writer.open(to, solver::CorpusKind::Sudoku, SquareSize))
+  {
+    std::cerr << "cannot convert " << from << std::endl;
+    return 1;
+  }
+  std::string line;
+  for (size_t number = 1U; std::getline(input, line); ++number)
+  {
+    if (!line.empty() && (line.back() == '\r'))
+    {
+      line.pop_back();
+    }
+    if (line.empty() || (line.front() == '#'))
+    {
+      continue;
+    }
+    const std::optional<grid_t> values = parse(line);
+    if (!values.has_value())
+    {
+      std::cerr << "invalid grid at line " << number << std::endl;
+      return 1;
+    }
+    writer.write(encode(*values));
+  }
+  return writer.close() ? 0 : 1;
+}
+
+// Mesure la durée moyenne de résolution pour une politique de domaine
+template<class SolverT>
+bool benchmark(const char* name, const grid_t& values, SolverT& algoC, const options_t& options)
+{
+  bool result = false;
+  std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+  for (size_t r = 0U; r < Repetitions; ++r)
+  {
+    algoC = SolverT{};
+    configure(algoC, options);
+    setup(algoC, values, options);
+    std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
+    result = algoC.solve();
+    duration += std::chrono::steady_clock::now() - start;
+  }
+  std::cout << "Duration[" << name << "]=" << (duration.count() / Repetitions) << "ns"
+            << " MemoryPerNode=" << algoC.memoryPerNode() << "B nodes=" << algoC.choicePoints() << std::endl;
+  return result;
+}
+
+// Mesure la durée moyenne de résolution d'un moteur spécialisé
+template<class KernelT>
+bool benchmark(const char* name, const grid_t& values, KernelT& algoL)
+{
+  bool result = false;
+  std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+  for (size_t r = 0U; r < Repetitions; ++r)
+  {
+    result = setup(algoL, values);
+    std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
+    result = result && algoL.solve();
+    duration += std::chrono::steady_clock::now() - start;
+  }
+  std::cout << "Duration[" << name << "]=" << (duration.count() / Repetitions) << "ns"
+            << " nodes=" << algoL.choicePoints() << std::endl;
+  return result;
+}
+
+int main(int argc, char* argv[]) 
+{
+  if ((argc > 3) && (std::string(argv[1]) == "--convert"))
+  {
+    return convert(argv[2], argv[3]);
+  }
+  if (argc > 1)
+  {
+    const size_t threads = (argc > 2) ? std::stoul(argv[2]) : std::max(std::thread::hardware_concurrency(), 1U);
+    const bool generic = (argc > 4) && (std::string(argv[4]) == "generic");
+    if (solver::isCorpusFile(argv[1]))
+    {
+      solver::MappedCorpus grids;
+      if (!grids.open(argv[1]))
+      {
+        std::cerr << "invalid corpus " << argv[1] << std::endl;
+        return 1;
+      }
+      return batch(grids, threads, (argc > 3) ? argv[3] : nullptr, generic);
+    }
+    return batch(argv[1], threads, (argc > 3) ? argv[3] : nullptr, generic);
+  }
+
   //-> Problème
   const std::string grid[] = {
     "8 0 0 0 0 0 0 4 0",
@@ -36,8 +349,8 @@ int main()
   //<-
 
   // Init
-  constexpr std::size_t SquareSize = std::extent_v<decltype(grid)>;
-  std::array<std::array<size_t,SquareSize>,SquareSize> values;
+  static_assert(std::extent_v<decltype(grid)> == SquareSize);
+  grid_t values;
   for (size_t i = 0U; i <  SquareSize; ++i) 
   {
     const std::string& str = grid[i];
@@ -51,99 +364,36 @@ int main()
     }
   }
 
-  // Programmation par contrainte
+  // Programmation par contrainte : les autres configurations du solveur générique (politique de domaine,
+  // retour arrière, heuristiques...) sont comparées par le banc d'essai (benchmark/benchmark.cpp)
   {
-    solver_constraint_t algoC;
-
-    algoC.setComparator([](const typename solver_constraint_t::variable_t& variable1,
-                        const typename solver_constraint_t::variable_t& variable2)
-    {
-      return variable1.domainSize() < variable2.domainSize();
-    } );
-
-    algoC.setSelector([](const typename solver_constraint_t::variable_t& variable)
-    {
-      return *(variable.domain().begin());
-    } );
-
-    algoC.addConstraint([](solver_constraint_t& solver, const tda::Coord coord, const size_t value)
-    {
-      bool sastified = true;
-      const size_t i = coord.X;
-      const size_t j = coord.Y;
-      // un seul chiffre sur une ligne
-      for (size_t k = 0U; (k < SquareSize) && sastified; ++k)
-      {
-        if (k != j)
-        {
-          sastified = solver.exclude(value, {i, k});
-        }
-      }
-      return sastified;
-    });
-  
-    algoC.addConstraint([](solver_constraint_t& solver, const tda::Coord coord, const size_t value)
-    {
-      bool sastified = true;
-      const size_t i = coord.X;
-      const size_t j = coord.Y;
-      // un seul chiffre sur une colonne
-      for (size_t k = 0U; (k < SquareSize) && sastified; ++k)
-      {
-        if (k != i)
-        {
-          sastified = solver.exclude(value, {k, j});
-        }
-      }
-      return sastified;
-    });
-
-    algoC.addConstraint([](solver_constraint_t& solver, const tda::Coord coord, const size_t value)
-    {
-      bool sastified = true;
-      const size_t i = coord.X;
-      const size_t j = coord.Y;
-      // un seul chiffre danns un carré
-      const size_t i1 = (i / 3U) * 3U;
-      const size_t j2 = (j / 3U) * 3U;
-      for (size_t k1 = i1; (k1 < i1 + 3U) && sastified; ++k1)
-      {
-        for (size_t k2 = j2; (k2 < j2 + 3U) && sastified; ++k2)
-        {
-          if ((k1 != i) || (k2 != j))
-          {
-              sastified = solver.exclude(value, {k1, k2});
-          }
-        }
-      }
-      return sastified;
-    });
-
-    const auto domain = tda::ValueEnum<SquareSize>;
-    for (size_t i = 0U; i < SquareSize; ++i)
-    {
-      for (size_t j = 0U; j < SquareSize; ++j)
-      {
-        if (values[i][j] == 0U)
-        {
-          algoC.addVariable(domain.begin(), domain.end(), {i, j});
-        }
-        else
-        {
-          algoC.addVariable({values[i][j]}, {i, j});
-        }
-      }
-    }
-
-    std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
-    bool result = algoC.solve();
-    std::cout << "Duration=" << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() << "ns" << std::endl;
+    constexpr solver::BacktrackMode Trail = solver::BacktrackMode::Trail;
+    solver_static_t algoC;
+    bool result = benchmark("bitset+trail+dense+static", values, algoC, {.Mode = Trail});
     std::cout << "success=" << std::boolalpha << result << std::endl;
+    std::cout << "statistics=";
+    algoC.statistics().writeJson(std::cout);
+    std::cout << std::endl;
+    // Unicité de la solution : dénombrement exact arrêté dès la deuxième solution
+    solver_static_t algoCount;
+    setup(algoCount, values);
+    std::cout << "unique=" << (algoCount.countExact(2U) == 1U) << std::endl;
+    // Moteurs spécialisés : même solution que le solveur générique
+    solver_latin_t algoL;
+    const bool latin = benchmark("bitboard", values, algoL);
+    std::cout << "bitboard=" << ((latin == result) &&
+                                 (format([&algoL](const tda::Coord& c) { return algoL.value(c); }) ==
+                                  format([&algoC](const tda::Coord& c) { return algoC.get(c).value(); }))) << std::endl;
+    solver_bands_t algoB;
+    const bool bands = benchmark("bands", values, algoB);
+    std::cout << "bands=" << ((bands == result) &&
+                              (format([&algoB](const tda::Coord& c) { return algoB.value(c); }) ==
+                               format([&algoC](const tda::Coord& c) { return algoC.get(c).value(); }))) << std::endl;
     for (size_t i = 0U; i < SquareSize; ++i)
     {
       for (size_t j = 0U; j < SquareSize; ++j)
       {
-        const typename solver_constraint_t::variable_t& variable = algoC.get({i, j});
+        const typename solver_static_t::variable_t& variable = algoC.get({i, j});
         if (variable.isInstantiated())
         {
           std::cout << variable.value();
@@ -0,0 +1,502 @@
+#ifndef SUDOKU_MODEL_H
+#define SUDOKU_MODEL_H
+
+#include <algorithm>
+#include <cmath>
+#include <array>
+#include <bitset>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "carre.h"
+#include "constraintSolver.h"
+#include "gridLoader.h"
+#include "latinSquare.h"
+#include "puzzleCorpus.h"
+#include "sudoku_bands.h"
+
+// Modèle du sudoku pour le solveur générique et le moteur spécialisé,
+// partagé par le programme sudoku et le banc d'essai
+namespace sudoku
+{
+  constexpr std::size_t SquareSize = 9U;
+
+  template<size_t N>
+  using square_t = std::array<std::array<size_t,N>,N>;
+  using grid_t = square_t<SquareSize>;
+  using solver_constraint_t = solver::ConstraintSolver<size_t, tda::Coord>;
+  using solver_bitset_t = solver::ConstraintSolver<size_t, tda::Coord, solver::BitsetDomain<size_t, SquareSize>>;
+  using solver_dense_t = solver::ConstraintSolver<size_t, tda::Coord, solver::BitsetDomain<size_t, SquareSize>, tda::CoordIndexer<SquareSize>>;
+  using solver_latin_t = solver::LatinSquare<SquareSize, 3U>;
+  using solver_bands_t = BandBoard;
+  // Moteur spécialisé d'une grille N x N (carrés B x B) : moteur par bandes pour 9 x 9, LatinSquare sinon
+  template<size_t B>
+  using kernel_t = std::conditional_t<B == 3U, solver_bands_t, solver::LatinSquare<B * B, B>>;
+
+  // Règles du sudoku : appelées pour chaque case nouvellement instanciée
+  const auto lineRule = [](auto& solver, const tda::Coord coord, const size_t value)
+  {
+    bool sastified = true;
+    const size_t i = coord.X;
+    const size_t j = coord.Y;
+    // un seul chiffre sur une ligne
+    for (size_t k = 0U; (k < SquareSize) && sastified; ++k)
+    {
+      if (k != j)
+      {
+        sastified = solver.exclude(value, {i, k});
+      }
+    }
+    return sastified;
+  };
+
+  const auto columnRule = [](auto& solver, const tda::Coord coord, const size_t value)
+  {
+    bool sastified = true;
+    const size_t i = coord.X;
+    const size_t j = coord.Y;
+    // un seul chiffre sur une colonne
+    for (size_t k = 0U; (k < SquareSize) && sastified; ++k)
+    {
+      if (k != i)
+      {
+        sastified = solver.exclude(value, {k, j});
+      }
+    }
+    return sastified;
+  };
+
+  const auto boxRule = [](auto& solver, const tda::Coord coord, const size_t value)
+  {
+    bool sastified = true;
+    const size_t i = coord.X;
+    const size_t j = coord.Y;
+    // un seul chiffre danns un carré
+    const size_t i1 = (i / 3U) * 3U;
+    const size_t j2 = (j / 3U) * 3U;
+    for (size_t k1 = i1; (k1 < i1 + 3U) && sastified; ++k1)
+    {
+      for (size_t k2 = j2; (k2 < j2 + 3U) && sastified; ++k2)
+      {
+        if ((k1 != i) || (k2 != j))
+        {
+            sastified = solver.exclude(value, {k1, k2});
+        }
+      }
+    }
+    return sastified;
+  };
+
+  using solver_static_t = solver::ConstraintSolver<size_t, tda::Coord, solver::BitsetDomain<size_t, SquareSize>, tda::CoordIndexer<SquareSize>,
+                                                   solver::StaticConstraints<decltype(lineRule), decltype(columnRule), decltype(boxRule)>>;
+
+  // Options de résolution comparées par le banc d'essai
+  struct options_t
+  {
+    solver::BacktrackMode Mode = solver::BacktrackMode::Copy;
+    size_t Threads = 1U;
+    std::optional<solver::Consistency> AllDifferent = std::nullopt;
+    solver::Heuristic Order = solver::Heuristic::Comparator;
+    bool Backjumping = false;
+    bool Decomposition = false;
+    solver::Restart Restarts = solver::Restart::None;
+    bool Randomize = false;
+  };
+
+  // Mode de retour arrière et options de recherche du solveur générique
+  template<class SolverT>
+  void configure(SolverT& algoC, const options_t& options)
+  {
+    algoC.setBacktrackMode(options.Mode);
+    algoC.setThreadCount(options.Threads);
+    algoC.setHeuristic(options.Order);
+    algoC.setBackjumping(options.Backjumping);
+    algoC.setDecomposition(options.Decomposition);
+    algoC.setRestarts(options.Restarts);
+    algoC.setRandomization(options.Randomize);
+  }
+
+  // Vrai si deux variables ont une valeur commune
+  template<class VariableT>
+  bool intersects(const VariableT& var1, const VariableT& var2)
+  {
+    return std::any_of(var1.domain().begin(), var1.domain().end(),
+                       [&var2](const size_t value) { return var2.canBe(value); });
+  }
+
+  // Modèle du sudoku : heuristiques et contraintes, communs à toutes les grilles
+  template<class SolverT>
+  void model(SolverT& algoC, const options_t& options = {})
+  {
+    algoC.setComparator([](const typename SolverT::variable_t& variable1,
+                        const typename SolverT::variable_t& variable2)
+    {
+      return variable1.domainSize() < variable2.domainSize();
+    } );
+
+    algoC.setSelector([](const typename SolverT::variable_t& variable)
+    {
+      return variable.domain().min();
+    } );
+
+    if constexpr (SolverT::StaticConstraintCount == 0U)
+    {
+      algoC.addConstraint(lineRule);
+      algoC.addConstraint(columnRule);
+      algoC.addConstraint(boxRule);
+    }
+
+    // Cases liées par les règles (dénombrement exact) : même ligne, même colonne ou même carré,
+    // tant que les deux domaines ont une valeur commune
+    algoC.setNeighbourhood([](const SolverT& solver, const tda::Coord& coord, std::vector<tda::Coord>& neighbours)
+    {
+      const typename SolverT::variable_t* var = solver.find(coord);
+      const size_t i1 = (coord.X / 3U) * 3U;
+      const size_t j1 = (coord.Y / 3U) * 3U;
+      for (size_t k = 0U; (k < SquareSize) && (var != nullptr); ++k)
+      {
+        for (const tda::Coord peer : {tda::Coord{coord.X, k}, tda::Coord{k, coord.Y}, tda::Coord{i1 + (k / 3U), j1 + (k % 3U)}})
+        {
+          if (const typename SolverT::variable_t* other = solver.find(peer); (other != nullptr) && intersects(*var, *other))
+          {
+            neighbours.push_back(peer);
+          }
+        }
+      }
+    } );
+
+    if (options.AllDifferent.has_value())
+    {
+      // Lignes, colonnes et carrés : intervalles de Hall ou couplage (paires et ensembles cachés)
+      for (size_t k = 0U; k < SquareSize; ++k)
+      {
+        std::vector<tda::Coord> line;
+        std::vector<tda::Coord> column;
+        std::vector<tda::Coord> box;
+        for (size_t l = 0U; l < SquareSize; ++l)
+        {
+          line.push_back({k, l});
+          column.push_back({l, k});
+          box.push_back({(k / 3U) * 3U + (l / 3U), (k % 3U) * 3U + (l % 3U)});
+        }
+        solver::addAllDifferent(algoC, line, *options.AllDifferent);
+        solver::addAllDifferent(algoC, column, *options.AllDifferent);
+        solver::addAllDifferent(algoC, box, *options.AllDifferent);
+      }
+    }
+  }
+
+  // Variables d'une grille : value(coord) donne le chiffre d'une case, 0 si elle est vide
+  template<class SolverT, class FctT>
+  void loadValues(SolverT& algoC, FctT&& value)
+  {
+    const auto domain = tda::ValueEnum<SquareSize>;
+    for (size_t i = 0U; i < SquareSize; ++i)
+    {
+      for (size_t j = 0U; j < SquareSize; ++j)
+      {
+        const size_t given = value(tda::Coord{i, j});
+        if (given == 0U)
+        {
+          algoC.addVariable(domain.begin(), domain.end(), {i, j});
+        }
+        else
+        {
+          algoC.addVariable({given}, {i, j});
+        }
+      }
+    }
+  }
+
+  template<class SolverT>
+  void load(SolverT& algoC, const grid_t& values)
+  {
+    loadValues(algoC, [&values](const tda::Coord& c) { return values[c.X][c.Y]; });
+  }
+
+  // Enregistrement du corpus binaire lisible par un solveur N x N : une case tient sur 4 bits et peut valoir jusqu'à 15
+  template<size_t N>
+  bool readable(const solver::GridView& view)
+  {
+    if (view.size() != N)
+    {
+      return false;
+    }
+    for (size_t i = 0U; i < N; ++i)
+    {
+      for (size_t j = 0U; j < N; ++j)
+      {
+        if (view.value({i, j}) > N)
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  // Variables d'une grille du corpus binaire, lues directement dans la projection, retourne false si l'enregistrement est illisible
+  template<class SolverT>
+  bool load(SolverT& algoC, const solver::GridView& view)
+  {
+    if (!readable<SquareSize>(view))
+    {
+      return false;
+    }
+    loadValues(algoC, [&view](const tda::Coord& c) { return view.value(c); });
+    return true;
+  }
+
+  template<class SolverT>
+    requires requires { typename SolverT::variable_t; }
+  void setup(SolverT& algoC, const grid_t& values, const options_t& options = {})
+  {
+    model(algoC, options);
+    load(algoC, values);
+  }
+
+  // Grille du moteur spécialisé N x N (carrés B x B), retourne false si deux chiffres donnés se contredisent
+  template<size_t N, size_t B, class FctT>
+  bool setupValues(solver::LatinSquare<N, B>& algoL, FctT&& value)
+  {
+    bool consistent = true;
+    algoL.clear();
+    for (size_t i = 0U; i < N; ++i)
+    {
+      for (size_t j = 0U; j < N; ++j)
+      {
+        const size_t given = value(tda::Coord{i, j});
+        if (given != 0U)
+        {
+          consistent = algoL.assign({i, j}, given) && consistent;
+        }
+      }
+    }
+    return consistent;
+  }
+
+  template<size_t N, size_t B>
+  bool setup(solver::LatinSquare<N, B>& algoL, const square_t<N>& values)
+  {
+    return setupValues(algoL, [&values](const tda::Coord& c) { return values[c.X][c.Y]; });
+  }
+
+  template<size_t N, size_t B>
+  bool setup(solver::LatinSquare<N, B>& algoL, const solver::GridView& view)
+  {
+    return readable<N>(view) && setupValues(algoL, [&view](const tda::Coord& c) { return view.value(c); });
+  }
+
+  // Grille du moteur par bandes, chargée en une fois
+  inline bool setup(solver_bands_t& algoB, const grid_t& values)
+  {
+    return algoB.load([&values](const tda::Coord& c) { return values[c.X][c.Y]; });
+  }
+
+  inline bool setup(solver_bands_t& algoB, const solver::GridView& view)
+  {
+    return readable<SquareSize>(view) && algoB.load([&view](const tda::Coord& c) { return view.value(c); });
+  }
+
+  // Solution sur une ligne de n x n cases (cellChar)
+  template<class FctT>
+  std::string format(const size_t n, FctT&& value)
+  {
+    std::string solution(n * n, '0');
+    for (size_t k = 0U; k < solution.size(); ++k)
+    {
+      solution[k] = solver::cellChar(value(tda::Coord{k / n, k % n}));
+    }
+    return solution;
+  }
+
+  template<size_t N = SquareSize, class FctT>
+  std::string format(FctT&& value)
+  {
+    return format(N, std::forward<FctT>(value));
+  }
+
+  // Une solution (format) est un carré latin N x N dont les carrés B x B ont chacun tous les chiffres,
+  // et qui respecte les chiffres donnés
+  template<size_t N = SquareSize, size_t B = 3U>
+  bool valid(const square_t<N>& givens, const std::string& solution)
+  {
+    static_assert(B * B == N);
+    const auto value = [&solution](const size_t i, const size_t j)
+    {
+      const size_t v = solver::cellValue(solution[(i * N) + j]).value_or(0U);
+      return (v <= N) ? v : 0U;
+    };
+    bool correct = (solution.size() == N * N);
+    for (size_t k = 0U; (k < N) && correct; ++k)
+    {
+      std::bitset<N + 1U> line;
+      std::bitset<N + 1U> column;
+      std::bitset<N + 1U> box;
+      for (size_t l = 0U; l < N; ++l)
+      {
+        line.set(value(k, l));
+        column.set(value(l, k));
+        box.set(value(((k / B) * B) + (l / B), ((k % B) * B) + (l % B)));
+        correct = correct && ((givens[k][l] == 0U) || (givens[k][l] == value(k, l)));
+      }
+      for (const std::bitset<N + 1U>& unit : {line, column, box})
+      {
+        correct = correct && !unit.test(0U) && (unit.count() == N);
+      }
+    }
+    return correct;
+  }
+
+  // Cases d'une grille n x n écrite sur une ligne (cellValue), std::nullopt si un caractère ne convient pas
+  inline std::optional<std::vector<size_t>> readGrid(const std::string& line, const size_t n)
+  {
+    std::optional<std::vector<size_t>> values;
+    if (line.size() == n * n)
+    {
+      values.emplace(line.size(), 0U);
+      for (size_t k = 0U; (k < line.size()) && values.has_value(); ++k)
+      {
+        const std::optional<size_t> value = solver::cellValue(line[k]);
+        if (value.has_value() && (*value <= n))
+        {
+          (*values)[k] = *value;
+        }
+        else
+        {
+          values.reset();
+        }
+      }
+    }
+    return values;
+  }
+
+  // Lecture d'une grille N x N sur une ligne de N x N caractères
+  template<size_t N = SquareSize>
+  std::optional<square_t<N>> parse(const std::string& line)
+  {
+    std::optional<square_t<N>> values;
+    if (const std::optional<std::vector<size_t>> cells = readGrid(line, N); cells.has_value())
+    {
+      values.emplace();
+      for (size_t k = 0U; k < cells->size(); ++k)
+      {
+        (*values)[k / N][k % N] = (*cells)[k];
+      }
+    }
+    return values;
+  }
+
+  // Taille N = B x B d'une grille écrite sur une ligne de N x N caractères, std::nullopt si aucune ne convient
+  inline std::optional<size_t> squareSize(const size_t length)
+  {
+    for (size_t b = 1U; b * b <= solver::TextMaxValue; ++b)
+    {
+      if (b * b * b * b == length)
+      {
+        return b * b;
+      }
+    }
+    return std::nullopt;
+  }
+
+  // Solveur du modèle dynamique, pour les tailles sans noyau instancié à la compilation
+  using dynamic_solver_t = solver::ConstraintSolver<size_t, tda::Coord>;
+
+  // Modèle dynamique d'une grille n x n (carrés b x b, n = b x b) : règles et lignes, colonnes et carrés filtrés
+  // selon allDifferent (std::nullopt : règles seules). Domain par défaut : les paires et ensembles cachés tranchent
+  // les grilles à 17 chiffres (9x9 : 1,3 ms par grille contre 20 ms aux bornes et 34 ms sans filtrage),
+  // quand les grilles faciles se résolvent plus vite sans couplage (0,2 ms contre 0,8 ms).
+  template<class SolverT>
+  void setupDynamic(SolverT& algoC, const size_t n, const std::vector<size_t>& values,
+                    const std::optional<solver::Consistency> allDifferent = solver::Consistency::Domain)
+  {
+    const size_t b = static_cast<size_t>(std::lround(std::sqrt(static_cast<double>(n))));
+    algoC.setComparator([](const typename SolverT::variable_t& variable1,
+                        const typename SolverT::variable_t& variable2)
+    {
+      return variable1.domainSize() < variable2.domainSize();
+    } );
+
+    algoC.setSelector([](const typename SolverT::variable_t& variable)
+    {
+      return variable.domain().min();
+    } );
+
+    // un seul chiffre sur une ligne, une colonne et dans un carré
+    algoC.addConstraint([n, b](SolverT& solver, const tda::Coord coord, const size_t value)
+    {
+      bool sastified = true;
+      const size_t i1 = (coord.X / b) * b;
+      const size_t j1 = (coord.Y / b) * b;
+      for (size_t k = 0U; (k < n) && sastified; ++k)
+      {
+        const tda::Coord box{i1 + (k / b), j1 + (k % b)};
+        for (const tda::Coord peer : {tda::Coord{coord.X, k}, tda::Coord{k, coord.Y}, box})
+        {
+          if ((peer != coord) && sastified)
+          {
+            sastified = solver.exclude(value, peer);
+          }
+        }
+      }
+      return sastified;
+    } );
+
+    // lignes, colonnes et carrés filtrés par couplage (Domain) ou par intervalles de Hall (Bounds)
+    if (allDifferent.has_value())
+    {
+      for (size_t k = 0U; k < n; ++k)
+      {
+        std::vector<tda::Coord> line;
+        std::vector<tda::Coord> column;
+        std::vector<tda::Coord> box;
+        for (size_t l = 0U; l < n; ++l)
+        {
+          line.push_back({k, l});
+          column.push_back({l, k});
+          box.push_back({(k / b) * b + (l / b), (k % b) * b + (l % b)});
+        }
+        solver::addAllDifferent(algoC, line, *allDifferent);
+        solver::addAllDifferent(algoC, column, *allDifferent);
+        solver::addAllDifferent(algoC, box, *allDifferent);
+      }
+    }
+
+    std::vector<size_t> domain(n);
+    std::iota(domain.begin(), domain.end(), 1U);
+    for (size_t i = 0U; i < n; ++i)
+    {
+      for (size_t j = 0U; j < n; ++j)
+      {
+        const size_t given = values[i * n + j];
+        if (given == 0U)
+        {
+          algoC.addVariable(domain.begin(), domain.end(), {i, j});
+        }
+        else
+        {
+          algoC.addVariable({given}, {i, j});
+        }
+      }
+    }
+  }
+
+  // Enregistrement du corpus binaire (conversion depuis le texte)
+  inline solver::GridRecord encode(const grid_t& values)
+  {
+    solver::GridRecord record(solver::CorpusKind::Sudoku, SquareSize);
+    for (size_t i = 0U; i < SquareSize; ++i)
+    {
+      for (size_t j = 0U; j < SquareSize; ++j)
+      {
+        record.setValue({i, j}, values[i][j]);
+      }
+    }
+    return record;
+  }
+}
+
+#endif
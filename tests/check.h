@@ -0,0 +1,33 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <cstddef>
+#include <iostream>
+
+// Vérifications des programmes de test : chaque échec est affiché et compté,
+// le programme retourne un code d'erreur s'il y en a eu (ctest)
+namespace check
+{
+  inline size_t Failures = 0U;
+
+  inline void
+  expect(const bool condition, const char *expression, const char *file, const int line)
+  {
+    if (!condition)
+    {
+      std::cerr << file << ":" << line << ": CHECK(" << expression << ") failed" << std::endl;
+      ++Failures;
+    }
+  }
+
+  inline int
+  result()
+  {
+    std::cout << ((Failures == 0U) ? "passed" : "failed") << " (" << Failures << " failures)" << std::endl;
+    return (Failures == 0U) ? 0 : 1;
+  }
+}
+
+#define CHECK(condition) check::expect((condition), #condition, __FILE__, __LINE__)
+
+#endif
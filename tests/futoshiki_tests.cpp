@@ -0,0 +1,510 @@
+/*
+ * futoshiki_tests.cpp
+ *
+ *
+ * @date 16-10-2026
+ * @version 1.00
+ * Tests du modèle du futoshiki : solutions valides pour chaque configuration, même arbre de recherche
+ * d'un mode de retour arrière à l'autre, même nombre de solutions d'un solveur à l'autre, grilles mal formées
+ */
+
+// ctest --test-dir build
+// Exécution directe : futoshikiTests [corpus]
+
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "check.h"
+#include "futoshiki_model.h"
+
+#ifndef TESTS_CORPUS_DIR
+#define TESTS_CORPUS_DIR "benchmark/corpus"
+#endif
+
+using namespace futoshiki;
+
+// Grilles par taille du corpus
+constexpr size_t GridsPerSize = 8U;
+
+// Premières grilles N x N d'un fichier du corpus (les 2N-1 lignes de la grille texte concaténées)
+std::vector<std::string> readCorpus(const std::string& path, const size_t count)
+{
+  std::vector<std::string> lines;
+  std::ifstream input(path);
+  std::string line;
+  while ((lines.size() < count) && std::getline(input, line))
+  {
+    if (!line.empty() && (line.back() == '\r'))
+    {
+      line.pop_back();
+    }
+    if (!line.empty() && (line.front() != '#'))
+    {
+      lines.push_back(line);
+    }
+  }
+  CHECK(lines.size() == count);
+  return lines;
+}
+
+template<size_t N>
+std::optional<puzzle_t<N>> parseLine(const std::string& line)
+{
+  std::vector<std::string> rows;
+  if (squareSize(line.size()) != N)
+  {
+    return std::nullopt;
+  }
+  splitRows(line, N, rows);
+  return parse<N>(rows);
+}
+
+// Solveur générique construit pour une grille
+template<class SolverT, size_t N>
+bool build(SolverT& algoC, const puzzle_t<N>& puzzle, const options_t& options)
+{
+  algoC = SolverT{};
+  configure(algoC, options);
+  return setup(algoC, puzzle.model(), options);
+}
+
+// Solution du solveur générique, vide s'il n'en trouve pas
+template<size_t N, class SolverT>
+std::string solveGeneric(SolverT& algoC)
+{
+  return algoC.solve() ? format<N>([&algoC](const tda::Coord& c) { return algoC.get(c).value(); }) : std::string();
+}
+
+// Solution du moteur spécialisé, vide s'il n'en trouve pas
+template<size_t N>
+std::string solveBitboard(const puzzle_t<N>& puzzle)
+{
+  solver::LatinSquare<N> algoL;
+  const bool solved = setup(algoL, puzzle.model()) && algoL.solve();
+  return solved ? format<N>([&algoL](const tda::Coord& c) { return algoL.value(c); }) : std::string();
+}
+
+// Le moteur spécialisé trouve une solution valide pour chaque grille
+template<size_t N>
+void testBitboard(const std::vector<std::string>& lines)
+{
+  for (const std::string& line : lines)
+  {
+    const std::optional<puzzle_t<N>> puzzle = parseLine<N>(line);
+    CHECK(puzzle.has_value() && valid(*puzzle, solveBitboard(*puzzle)));
+  }
+}
+
+// Chaque configuration du solveur générique et le modèle dynamique trouvent la solution (unique) du moteur spécialisé
+template<size_t N>
+void testSolutions(const std::vector<std::string>& lines)
+{
+  constexpr solver::BacktrackMode Trail = solver::BacktrackMode::Trail;
+  const std::vector<options_t> configurations = {
+    {},
+    {.Mode = Trail},
+    {.Mode = Trail, .EventDriven = false},
+    {.Mode = Trail, .Threads = 4U},
+    {.Mode = Trail, .AllDifferent = solver::Consistency::Bounds},
+    {.Mode = Trail, .AllDifferent = solver::Consistency::Domain},
+    {.Mode = Trail, .Order = solver::Heuristic::DomWdeg, .Backjumping = true},
+    {.Mode = Trail, .Decomposition = true},
+    {.Mode = Trail, .Order = solver::Heuristic::DomWdeg, .Restarts = solver::Restart::Luby, .Randomize = true},
+  };
+  for (const std::string& line : lines)
+  {
+    const std::optional<puzzle_t<N>> puzzle = parseLine<N>(line);
+    CHECK(puzzle.has_value());
+    if (!puzzle.has_value())
+    {
+      continue;
+    }
+    const std::string expected = solveBitboard(*puzzle);
+    CHECK(valid(*puzzle, expected));
+    for (const options_t& options : configurations)
+    {
+      dense_solver_t<N> algoC;
+      CHECK(build(algoC, *puzzle, options));
+      CHECK(solveGeneric<N>(algoC) == expected);
+    }
+    static_solver_t<N> algoS;
+    CHECK(build(algoS, *puzzle, {.Mode = Trail}));
+    CHECK(solveGeneric<N>(algoS) == expected);
+
+    std::vector<std::string> rows;
+    splitRows(line, N, rows);
+    const std::optional<dynamic_puzzle_t> dynamic = parseDynamic(rows, N);
+    CHECK(dynamic.has_value());
+    // mêmes domaines resserrés que le modèle de taille connue à la compilation
+    bool sameRanges = (dynamic->Ranges.size() == puzzle->Ranges.size());
+    for (size_t cell = 0U; sameRanges && (cell < N * N); ++cell)
+    {
+      sameRanges = (dynamic->Ranges[cell].Min == puzzle->Ranges[cell].Min) && (dynamic->Ranges[cell].Max == puzzle->Ranges[cell].Max);
+    }
+    CHECK(sameRanges);
+    // même solution quel que soit le filtrage des lignes et des colonnes
+    for (const std::optional<solver::Consistency> allDifferent :
+         {std::optional<solver::Consistency>(solver::Consistency::Bounds), std::optional<solver::Consistency>(solver::Consistency::Domain),
+          std::optional<solver::Consistency>()})
+    {
+      dynamic_solver_t algoD;
+      CHECK(setupDynamic(algoD, *dynamic, allDifferent));
+      CHECK(solveGeneric<N>(algoD) == expected);
+    }
+  }
+}
+
+// Modèle dynamique : domaines resserrés comme pour une taille connue à la compilation, grille sans solution refusée
+void testDynamicRanges()
+{
+  // chaîne 0 < 0 < 0 < 0 sur la première ligne : une seule valeur par case
+  std::vector<std::string> rows = {"0<0<0<0", "       ", "0 0 0 0", "       ", "0 0 0 0", "       ", "0 0 0 0"};
+  std::optional<dynamic_puzzle_t> puzzle = parseDynamic(rows, 4U);
+  CHECK(puzzle.has_value() && (puzzle->Ranges.size() == 16U));
+  for (size_t j = 0U; puzzle.has_value() && (j < 4U); ++j)
+  {
+    CHECK((puzzle->Ranges[j].Min == j + 1U) && (puzzle->Ranges[j].Max == j + 1U));
+  }
+  dynamic_solver_t algoD;
+  CHECK(puzzle.has_value() && setupDynamic(algoD, *puzzle) && algoD.solve());
+  // (0, 1) donné à 1 n'a aucune case inférieure possible
+  rows[0U] = "0<1 0 0";
+  puzzle = parseDynamic(rows, 4U);
+  CHECK(puzzle.has_value());
+  dynamic_solver_t algoE;
+  CHECK(puzzle.has_value() && !setupDynamic(algoE, *puzzle));
+}
+
+// Les retours arrière par copie et par journal parcourent le même arbre, quelle que soit l'heuristique
+template<size_t N>
+void testSameTree(const std::vector<std::string>& lines)
+{
+  for (const solver::Heuristic order : {solver::Heuristic::Comparator, solver::Heuristic::Dom, solver::Heuristic::DomWdeg,
+                                        solver::Heuristic::Impact})
+  {
+    for (const std::string& line : lines)
+    {
+      const std::optional<puzzle_t<N>> puzzle = parseLine<N>(line);
+      CHECK(puzzle.has_value());
+      if (!puzzle.has_value())
+      {
+        continue;
+      }
+      static_solver_t<N> algoCopy;
+      static_solver_t<N> algoTrail;
+      CHECK(build(algoCopy, *puzzle, {.Order = order}));
+      CHECK(build(algoTrail, *puzzle, {.Mode = solver::BacktrackMode::Trail, .Order = order}));
+      CHECK(solveGeneric<N>(algoCopy) == solveGeneric<N>(algoTrail));
+      CHECK(algoCopy.choicePoints() == algoTrail.choicePoints());
+    }
+  }
+}
+
+// Même nombre de solutions pour le moteur spécialisé, l'énumération et le dénombrement exact du solveur générique
+template<size_t N>
+void testCounts(const std::string& line)
+{
+  // grille privée de ses derniers chiffres donnés jusqu'à avoir plusieurs solutions
+  std::string text = line;
+  std::optional<puzzle_t<N>> puzzle = parseLine<N>(text);
+  solver::LatinSquare<N> algoL;
+  for (size_t k = text.size(); (k > 0U) && puzzle.has_value() && setup(algoL, puzzle->model()) && (algoL.countSolutions(2U) < 2U); --k)
+  {
+    if ((text[k - 1U] >= '1') && (text[k - 1U] <= '9'))
+    {
+      text[k - 1U] = '0';
+      puzzle = parseLine<N>(text);
+    }
+  }
+  CHECK(puzzle.has_value());
+  if (!puzzle.has_value())
+  {
+    return;
+  }
+  CHECK(setup(algoL, puzzle->model()));
+  const size_t expected = algoL.countSolutions();
+  CHECK(expected > 1U);
+  for (const solver::BacktrackMode mode : {solver::BacktrackMode::Copy, solver::BacktrackMode::Trail})
+  {
+    static_solver_t<N> algoC;
+    CHECK(build(algoC, *puzzle, {.Mode = mode}));
+    CHECK(algoC.countSolutions() == expected);
+    CHECK(build(algoC, *puzzle, {.Mode = mode}));
+    CHECK(algoC.countExact() == expected);
+    CHECK(build(algoC, *puzzle, {.Mode = mode, .EventDriven = false}));
+    CHECK(algoC.countExact() == expected);
+  }
+  static_solver_t<N> algoD;
+  CHECK(build(algoD, *puzzle, {.Mode = solver::BacktrackMode::Trail, .Decomposition = true}));
+  CHECK(algoD.countSolutions() == expected);
+}
+
+// Grilles mal formées : nombre de lignes, ligne trop longue, caractère ou valeur hors de la grille, cycle d'inégalités
+void testMalformed()
+{
+  const std::vector<std::string> grid = {
+    "0 0 0 0",
+    "       ",
+    "0 0<0 0",
+    "       ",
+    "0 0 0 0",
+    "       ",
+    "0 0 0 0"
+  };
+  CHECK(parse<4U>(grid).has_value());
+  CHECK(!parse<4U>({grid.begin(), grid.end() - 1}).has_value());
+  CHECK(!parse<5U>(grid).has_value());
+  std::vector<std::string> rows = grid;
+  rows[0U] = "0 0 0 0 ";
+  CHECK(!parse<4U>(rows).has_value());
+  rows[0U] = "0 0 # 0";
+  CHECK(!parse<4U>(rows).has_value());
+  rows[0U] = "0 0 5 0";
+  CHECK(!parse<4U>(rows).has_value());
+  rows[0U] = "0 0 4 0";
+  CHECK(parse<4U>(rows).has_value());
+  // cycle (0, 0) < (0, 1) < (1, 1) < (1, 0) < (0, 0)
+  rows = grid;
+  rows[0U] = "0<0 0 0";
+  rows[1U] = "v ^    ";
+  rows[2U] = "0>0 0 0";
+  CHECK(!parse<4U>(rows).has_value());
+  CHECK(!parseDynamic(rows, 4U).has_value());
+  // inégalités hors de leur position : '<' '>' entre deux cases d'une ligne, '^' 'v' entre deux cases d'une colonne
+  const std::vector<std::pair<size_t, std::string>> misplaced = {
+    {0U, "0 0 0 <"}, {0U, "<0 0 0"}, {1U, "  <    "}, {1U, " >     "}, {2U, "0 0 0 >"},
+    {6U, "0 0 0 v"}, {5U, " v     "}, {0U, "0 0^0 0"}, {0U, "v 0 0 0"}, {1U, "     ^ "}, {4U, "0 0 0 0^"}
+  };
+  for (const auto& [row, text] : misplaced)
+  {
+    rows = grid;
+    rows[row] = text;
+    CHECK(!parse<4U>(rows).has_value());
+    CHECK(!parseDynamic(rows, 4U).has_value());
+  }
+  rows = grid;
+  rows[5U] = "      v";
+  rows[6U] = "0 0 0>0";
+  CHECK(parse<4U>(rows).has_value());
+}
+
+// Filtrage des inégalités sur deux cases voisines déjà instanciées : il échoue si elles contredisent leur inégalité
+void testInstantiated()
+{
+  const std::optional<puzzle_t<4U>> puzzle = parse<4U>({"0<0 0 0", "       ", "0 0 0 0", "       ", "0 0 0 0", "       ", "0 0 0 0"});
+  CHECK(puzzle.has_value());
+  if (!puzzle.has_value())
+  {
+    return;
+  }
+  for (const solver::BacktrackMode mode : {solver::BacktrackMode::Copy, solver::BacktrackMode::Trail})
+  {
+    for (const auto& [inf, sup, satisfied] : {std::tuple{3U, 2U, false}, std::tuple{2U, 3U, true}})
+    {
+      static_solver_t<4U> algoC;
+      CHECK(build(algoC, *puzzle, {.Mode = mode, .EventDriven = false}));
+      // (0, 0) dans [1, 3] et (0, 1) dans [2, 4] après la mise en place
+      for (size_t k = 1U; k <= 4U; ++k)
+      {
+        CHECK((k == inf) || !algoC.get({0U, 0U}).canBe(k) || algoC.exclude(k, {0U, 0U}));
+        CHECK((k == sup) || !algoC.get({0U, 1U}).canBe(k) || algoC.exclude(k, {0U, 1U}));
+      }
+      CHECK(algoC.get({0U, 0U}).isInstantiated() && algoC.get({0U, 1U}).isInstantiated());
+      CHECK(inequal(algoC, puzzle->ConstraintsOrder, puzzle->Inequalities) == satisfied);
+    }
+  }
+}
+
+// Solveur mis en place depuis le temporaire puzzle_t::model(), puis utilisé après sa destruction
+template<size_t N>
+void testTemporaryModel(const std::string& line)
+{
+  const std::optional<puzzle_t<N>> puzzle = parseLine<N>(line);
+  CHECK(puzzle.has_value());
+  if (!puzzle.has_value())
+  {
+    return;
+  }
+  const std::string expected = solveBitboard(*puzzle);
+  for (const bool eventDriven : {true, false})
+  {
+    static_solver_t<N> algoC;
+    configure(algoC, {.Mode = solver::BacktrackMode::Trail, .EventDriven = eventDriven});
+    CHECK(setup(algoC, puzzle->model(), {.Mode = solver::BacktrackMode::Trail, .EventDriven = eventDriven}));
+    // la pile du temporaire est réutilisée avant la recherche
+    CHECK(parseLine<N>(line).has_value());
+    CHECK(solveGeneric<N>(algoC) == expected);
+    static_solver_t<N> algoE;
+    configure(algoE, {.Mode = solver::BacktrackMode::Trail, .EventDriven = eventDriven});
+    CHECK(setup(algoE, puzzle->model(), {.Mode = solver::BacktrackMode::Trail, .EventDriven = eventDriven}));
+    CHECK(parseLine<N>(line).has_value());
+    CHECK(algoE.countExact() == 1U);
+  }
+}
+
+// Enregistrement du corpus binaire : même lecture que la grille texte pour le moteur spécialisé
+void testRecord()
+{
+  solver::GridRecord record(solver::CorpusKind::Futoshiki, 4U);
+  record.setRight({0U, 0U}, solver::Relation::Less);
+  record.setValue({0U, 1U}, 2U);
+  solver::LatinSquare<4U> algoL;
+  CHECK(setup(algoL, record.view()) && algoL.solve() && (algoL.value({0U, 0U}) == 1U));
+  // (0, 1) donné à 1 n'a aucune case inférieure possible : domaine vide après resserrement
+  record.setValue({0U, 1U}, 1U);
+  CHECK(decode<4U>(record.view()).has_value());
+  CHECK(!setup(algoL, record.view()));
+  // cycle (0, 0) < (0, 1) < (1, 1) < (1, 0) < (0, 0)
+  record.setValue({0U, 1U}, 0U);
+  record.setDown({0U, 1U}, solver::Relation::Less);
+  record.setRight({1U, 0U}, solver::Relation::Greater);
+  record.setDown({0U, 0U}, solver::Relation::Greater);
+  CHECK(!decode<4U>(record.view()).has_value());
+  CHECK(!setup(algoL, record.view()));
+  CHECK(!setup(algoL, solver::GridRecord(solver::CorpusKind::Futoshiki, 5U).view()));
+}
+
+// Graphe des inégalités : une inégalité dont une case sort de la grille est rejetée avant la construction
+void testInequalityGraph()
+{
+  using graph_t = tda::InequalityGraph<4U>;
+  const graph_t graph({tda::InferiorConstraint({0U, 0U}, tda::Direction::Right), tda::InferiorConstraint({1U, 0U}, tda::Direction::Up)});
+  CHECK(graph.valid() && (graph.size() == 2U));
+  // 'v' sur la dernière ligne "0 0 0 v" d'une grille 4 x 4 : case inférieure (4, 3)
+  const graph_t below({tda::InferiorConstraint({0U, 0U}, tda::Direction::Right), tda::InferiorConstraint({4U, 3U}, tda::Direction::Up)});
+  CHECK(!below.valid() && (below.size() == 1U));
+  CHECK(below.successors(graph_t::index({0U, 0U})).size() == 1U);
+  // case supérieure au-dessus de la première ligne, après la dernière colonne ou avant la première
+  CHECK(!graph_t({tda::InferiorConstraint({0U, 2U}, tda::Direction::Up)}).valid());
+  CHECK(!graph_t({tda::InferiorConstraint({2U, 3U}, tda::Direction::Right)}).valid());
+  CHECK(!graph_t({tda::InferiorConstraint({2U, 0U}, tda::Direction::Left)}).valid());
+  CHECK(!graph_t({tda::InferiorConstraint({3U, 1U}, tda::Direction::Down)}).valid());
+  // la grille est refusée
+  puzzle_t<4U> puzzle;
+  CHECK(!addConstraints(puzzle, {tda::InferiorConstraint({3U, 3U}, tda::Direction::Down)}));
+  CHECK(addConstraints(puzzle, {tda::InferiorConstraint({3U, 3U}, tda::Direction::Up)}));
+}
+
+// Violations comptées comme avant les masques de valeurs : doublon dans une ligne ou une colonne, inégalité non respectée
+template<size_t N>
+size_t referenceViolations(const tda::Futoshiki<N>& futoshiki, const std::vector<tda::InferiorConstraint>& constraints)
+{
+  size_t violations = 0U;
+  std::array<std::array<bool, N>, N> lines{};
+  std::array<std::array<bool, N>, N> columns{};
+  for (size_t i = 0U; i < N; ++i)
+  {
+    for (size_t j = 0U; j < N; ++j)
+    {
+      const size_t value = futoshiki.getValue({i, j}) - 1U;
+      violations += lines[i][value] ? 1U : 0U;
+      violations += columns[j][value] ? 1U : 0U;
+      lines[i][value] = true;
+      columns[j][value] = true;
+    }
+  }
+  for (const tda::InferiorConstraint& c : constraints)
+  {
+    violations += (futoshiki.getValue(c.Inf()) >= futoshiki.getValue(c.Sup())) ? 1U : 0U;
+  }
+  return violations;
+}
+
+// Violations du recuit simulé sur des grilles tirées au hasard : même compte que la boucle de référence
+template<size_t N>
+void testViolations(std::mt19937& generator)
+{
+  std::uniform_int_distribution<size_t> cell(0U, N - 1U);
+  std::uniform_int_distribution<size_t> value(1U, N);
+  std::uniform_int_distribution<int> direction(0, 3);
+  for (size_t round = 0U; round < 50U; ++round)
+  {
+    std::vector<tda::InferiorConstraint> constraints;
+    for (size_t k = 0U; k < N; ++k)
+    {
+      const tda::Coord inf{cell(generator), cell(generator)};
+      const tda::Direction side = static_cast<tda::Direction>(direction(generator));
+      const bool inside = ((side != tda::Direction::Up) || (inf.X > 0U)) && ((side != tda::Direction::Down) || (inf.X + 1U < N)) &&
+                          ((side != tda::Direction::Left) || (inf.Y > 0U)) && ((side != tda::Direction::Right) || (inf.Y + 1U < N));
+      if (inside)
+      {
+        constraints.push_back(tda::InferiorConstraint(inf, side));
+      }
+    }
+    tda::Futoshiki<N> futoshiki(constraints, {tda::Assertion{{0U, 0U}, 1U}});
+    CHECK(futoshiki.getViolationsCount() == referenceViolations(futoshiki, constraints));
+    for (size_t k = 0U; k < 4U * N; ++k)
+    {
+      futoshiki.setValue({{cell(generator), cell(generator)}, value(generator)});
+      CHECK(futoshiki.getViolationsCount() == referenceViolations(futoshiki, constraints));
+    }
+  }
+}
+
+// Violations du recuit simulé sur des grilles construites à la main
+void testViolationCounts()
+{
+  // première solution du constructeur : chaque ligne vaut 1 2 3, chaque colonne répète sa valeur deux fois
+  const std::vector<tda::InferiorConstraint> constraints = {tda::InferiorConstraint({0U, 0U}, tda::Direction::Right),
+                                                            tda::InferiorConstraint({1U, 2U}, tda::Direction::Up)};
+  tda::Futoshiki<3U> futoshiki(constraints, {});
+  CHECK(futoshiki.getViolationsCount() == 6U + 1U);
+  // carré latin 1 2 3 / 2 3 1 / 3 1 2 : (0, 0) = 1 < (0, 1) = 2 et (1, 2) = 1 < (0, 2) = 3 sont respectées
+  const std::array<std::array<size_t, 3U>, 3U> latin = {{{1U, 2U, 3U}, {2U, 3U, 1U}, {3U, 1U, 2U}}};
+  for (size_t i = 0U; i < 3U; ++i)
+  {
+    for (size_t j = 0U; j < 3U; ++j)
+    {
+      futoshiki.setValue({{i, j}, latin[i][j]});
+    }
+  }
+  CHECK(futoshiki.getViolationsCount() == 0U);
+  futoshiki.setValue({{0U, 0U}, 2U});
+  // un doublon sur la ligne 0, un sur la colonne 0, (0, 0) = 2 < (0, 1) = 2 non respectée
+  CHECK(futoshiki.getViolationsCount() == 3U);
+  // grille de 1 : deux doublons par ligne et par colonne, aucune inégalité respectée
+  for (size_t i = 0U; i < 3U; ++i)
+  {
+    for (size_t j = 0U; j < 3U; ++j)
+    {
+      futoshiki.setValue({{i, j}, 1U});
+    }
+  }
+  CHECK(futoshiki.getViolationsCount() == 12U + 2U);
+}
+
+int main(int argc, char* argv[])
+{
+  const std::string corpus = (argc > 1) ? argv[1] : TESTS_CORPUS_DIR;
+  const auto lines = [&corpus](const size_t n)
+  {
+    return readCorpus(corpus + "/futoshiki_" + std::to_string(n) + ".txt", GridsPerSize);
+  };
+  testBitboard<6U>(lines(6U));
+  testBitboard<7U>(lines(7U));
+  testBitboard<8U>(lines(8U));
+  testSolutions<5U>(lines(5U));
+  testSolutions<9U>(lines(9U));
+  testSameTree<5U>(lines(5U));
+  testSameTree<9U>(lines(9U));
+  testCounts<5U>(lines(5U).front());
+  testMalformed();
+  testDynamicRanges();
+  testInstantiated();
+  testRecord();
+  testTemporaryModel<5U>(lines(5U).front());
+  testInequalityGraph();
+  testViolationCounts();
+  std::mt19937 generator(2026U);
+  testViolations<1U>(generator);
+  testViolations<4U>(generator);
+  testViolations<9U>(generator);
+  testViolations<16U>(generator);
+  return check::result();
+}
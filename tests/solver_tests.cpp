@@ -0,0 +1,230 @@
+/*
+ * solver_tests.cpp
+ *
+ *
+ * @date 16-10-2026
+ * @version 1.00
+ * Tests des outils communs aux solveurs : traitement par lots, corpus binaire projeté en mémoire
+ */
+
+// ctest --test-dir build
+// Exécution directe : solverTests [répertoire temporaire]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "check.h"
+#include "batchPipeline.h"
+
+// Traitement par lots : résultats écrits dans l'ordre de l'entrée, au plus window problèmes lus et non écrits
+void testPipeline(const size_t threads, const size_t window)
+{
+  constexpr size_t Problems = 64U;
+  size_t next = 0U;
+  std::vector<size_t> written;
+  std::atomic<size_t> started = 0U;
+  std::atomic<size_t> done = 0U;
+  std::atomic<size_t> widest = 0U;
+  const solver::BatchReport report = solver::runPipeline(
+    [&next]()
+    {
+      std::optional<size_t> problem;
+      if (next < Problems)
+      {
+        problem = next;
+        ++next;
+      }
+      return problem;
+    },
+    [&written, &done](size_t&& result)
+    {
+      written.push_back(result);
+      ++done;
+    },
+    threads,
+    []()
+    {
+      return size_t{0U};
+    },
+    [&started, &done, &widest](size_t& solved, const size_t& problem)
+    {
+      // problèmes confiés à un fil et pas encore écrits, celui-ci compris
+      const size_t open = ++started - done;
+      size_t seen = widest;
+      while ((open > seen) && !widest.compare_exchange_weak(seen, open))
+      {
+      }
+      // les premiers problèmes de chaque tranche finissent après les suivants
+      std::this_thread::sleep_for(std::chrono::microseconds((problem % 8U == 0U) ? 2000U : 50U));
+      ++solved;
+      return problem * problem;
+    },
+    window);
+  CHECK(report.Puzzles == Problems);
+  CHECK(written.size() == Problems);
+  for (size_t k = 0U; k < written.size(); ++k)
+  {
+    CHECK(written[k] == k * k);
+  }
+  CHECK((widest > 0U) && (widest <= window));
+}
+
+// Traitement par lots d'un corpus texte : lignes vides et commentaires ignorés, ordre conservé
+void testTextBatch()
+{
+  std::istringstream input("# corpus\n3\n\n1\r\n4\n# fin\n1\n5\n");
+  std::ostringstream output;
+  const solver::BatchReport report = solver::runBatch(input, output, 3U,
+    []()
+    {
+      return size_t{0U};
+    },
+    [](size_t&, const std::string& line)
+    {
+      return line + line;
+    },
+    2U);
+  CHECK(report.Puzzles == 5U);
+  CHECK(output.str() == "33\n11\n44\n11\n55\n");
+}
+
+// Contenu d'un fichier
+std::vector<std::uint8_t> readBytes(const std::string& path)
+{
+  std::ifstream input(path, std::ios::binary);
+  return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+}
+
+void writeBytes(const std::string& path, const std::vector<std::uint8_t>& bytes)
+{
+  std::ofstream output(path, std::ios::binary | std::ios::trunc);
+  output.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+// Corpus binaire : un corpus écrit puis projeté relit les mêmes enregistrements, un fichier tronqué
+// ou d'un autre format est refusé
+void testCorpus(const std::string& directory)
+{
+  constexpr size_t N = 5U;
+  const std::string path = directory + "/solver_tests_corpus.bin";
+  const std::string damaged = directory + "/solver_tests_damaged.bin";
+  std::vector<solver::GridRecord> records;
+  for (size_t k = 0U; k < 7U; ++k)
+  {
+    solver::GridRecord record(solver::CorpusKind::Futoshiki, N);
+    for (size_t i = 0U; i < N; ++i)
+    {
+      for (size_t j = 0U; j < N; ++j)
+      {
+        record.setValue({i, j}, (i + j + k) % (N + 1U));
+        if (j + 1U < N)
+        {
+          record.setRight({i, j}, static_cast<solver::Relation>((i * j + k) % 3U));
+        }
+        if (i + 1U < N)
+        {
+          record.setDown({i, j}, static_cast<solver::Relation>((i + 2U * j + k) % 3U));
+        }
+      }
+    }
+    records.push_back(record);
+  }
+  solver::CorpusWriter writer;
+  CHECK(writer.open(path, solver::CorpusKind::Futoshiki, N));
+  for (const solver::GridRecord& record : records)
+  {
+    CHECK(writer.write(record));
+  }
+  CHECK(!writer.write(solver::GridRecord(solver::CorpusKind::Futoshiki, N + 1U)));
+  CHECK(writer.close());
+
+  CHECK(solver::isCorpusFile(path));
+  solver::MappedCorpus corpus;
+  CHECK(corpus.open(path));
+  CHECK((corpus.kind() == solver::CorpusKind::Futoshiki) && (corpus.size() == N) && (corpus.count() == records.size()));
+  for (size_t k = 0U; (k < records.size()) && (k < corpus.count()); ++k)
+  {
+    const solver::GridView view = corpus[k];
+    const solver::GridView expected = records[k].view();
+    bool same = true;
+    for (size_t i = 0U; i < N; ++i)
+    {
+      for (size_t j = 0U; j < N; ++j)
+      {
+        same = same && (view.value({i, j}) == expected.value({i, j}));
+        same = same && ((j + 1U == N) || (view.right({i, j}) == expected.right({i, j})));
+        same = same && ((i + 1U == N) || (view.down({i, j}) == expected.down({i, j})));
+      }
+    }
+    CHECK(same);
+  }
+
+  // traitement par lots du corpus projeté : une vue par enregistrement, dans l'ordre
+  std::vector<size_t> firsts;
+  const solver::BatchReport report = solver::runBatch(corpus, [&firsts](size_t&& value) { firsts.push_back(value); }, 3U,
+    []()
+    {
+      return size_t{0U};
+    },
+    [](size_t&, const solver::GridView& view)
+    {
+      return view.value({0U, 0U});
+    },
+    2U);
+  CHECK(report.Puzzles == records.size());
+  for (size_t k = 0U; k < firsts.size(); ++k)
+  {
+    CHECK(firsts[k] == records[k].view().value({0U, 0U}));
+  }
+
+  const std::vector<std::uint8_t> bytes = readBytes(path);
+  CHECK(bytes.size() == solver::CorpusHeaderSize + records.size() * solver::recordSize(solver::CorpusKind::Futoshiki, N));
+  solver::MappedCorpus refused;
+  // dernier enregistrement incomplet
+  writeBytes(damaged, std::vector<std::uint8_t>(bytes.begin(), bytes.end() - 1));
+  CHECK(!refused.open(damaged));
+  // en-tête incomplet
+  writeBytes(damaged, std::vector<std::uint8_t>(bytes.begin(), bytes.begin() + solver::CorpusHeaderSize - 1));
+  CHECK(!refused.open(damaged));
+  // autre format
+  std::vector<std::uint8_t> altered = bytes;
+  altered[0U] = 'X';
+  writeBytes(damaged, altered);
+  CHECK(!solver::isCorpusFile(damaged));
+  CHECK(!refused.open(damaged));
+  // autre version
+  altered = bytes;
+  altered[8U] = 2U;
+  writeBytes(damaged, altered);
+  CHECK(!refused.open(damaged));
+  // taille d'enregistrement qui ne correspond pas à la nature
+  altered = bytes;
+  altered[12U] = static_cast<std::uint8_t>(solver::CorpusKind::Sudoku);
+  writeBytes(damaged, altered);
+  CHECK(!refused.open(damaged));
+  CHECK(!refused.open(directory + "/solver_tests_missing.bin"));
+  CHECK(refused.count() == 0U);
+
+  std::filesystem::remove(path);
+  std::filesystem::remove(damaged);
+}
+
+int main(int argc, char* argv[])
+{
+  const std::string directory = (argc > 1) ? argv[1] : std::filesystem::temp_directory_path().string();
+  testPipeline(1U, 1U);
+  testPipeline(4U, 3U);
+  testPipeline(4U, 64U);
+  testTextBatch();
+  testCorpus(directory);
+  return check::result();
+}
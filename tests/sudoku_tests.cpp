@@ -0,0 +1,449 @@
+/*
+ * sudoku_tests.cpp
+ *
+ *
+ * @date 16-10-2026
+ * @version 1.00
+ * Tests du modèle du sudoku : solutions valides pour chaque configuration, même arbre de recherche
+ * d'un mode de retour arrière à l'autre, même nombre de solutions d'un solveur à l'autre, grilles mal formées
+ */
+
+// ctest --test-dir build
+// Exécution directe : sudokuTests [corpus]
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "check.h"
+#include "sudoku_model.h"
+
+#ifndef TESTS_CORPUS_DIR
+#define TESTS_CORPUS_DIR "benchmark/corpus"
+#endif
+
+using namespace sudoku;
+
+// Grilles par niveau du corpus
+constexpr size_t GridsPerLevel = 8U;
+
+// Premières grilles d'un fichier du corpus, sans les commentaires
+std::vector<grid_t> readCorpus(const std::string& path, const size_t count)
+{
+  std::vector<grid_t> grids;
+  std::ifstream input(path);
+  std::string line;
+  while ((grids.size() < count) && std::getline(input, line))
+  {
+    if (!line.empty() && (line.back() == '\r'))
+    {
+      line.pop_back();
+    }
+    if (const std::optional<grid_t> values = parse(line); !line.empty() && (line.front() != '#') && values.has_value())
+    {
+      grids.push_back(*values);
+    }
+  }
+  CHECK(grids.size() == count);
+  return grids;
+}
+
+// Solveur générique construit pour une grille
+template<class SolverT>
+void build(SolverT& algoC, const grid_t& values, const options_t& options)
+{
+  algoC = SolverT{};
+  configure(algoC, options);
+  setup(algoC, values, options);
+}
+
+// Solution du solveur générique, vide s'il n'en trouve pas
+template<class SolverT>
+std::string solveGeneric(SolverT& algoC)
+{
+  return algoC.solve() ? format([&algoC](const tda::Coord& c) { return algoC.get(c).value(); }) : std::string();
+}
+
+// Chaque configuration du solveur générique et le moteur spécialisé trouvent une solution valide
+void testSolutions(const std::vector<grid_t>& grids)
+{
+  constexpr solver::BacktrackMode Trail = solver::BacktrackMode::Trail;
+  const std::vector<options_t> configurations = {
+    {},
+    {.Mode = Trail},
+    {.Mode = Trail, .Threads = 4U},
+    {.Mode = Trail, .AllDifferent = solver::Consistency::Bounds},
+    {.Mode = Trail, .AllDifferent = solver::Consistency::Domain},
+    {.Mode = Trail, .Order = solver::Heuristic::DomWdeg, .Backjumping = true},
+    {.Mode = Trail, .Decomposition = true},
+    {.Mode = Trail, .Order = solver::Heuristic::DomWdeg, .Restarts = solver::Restart::Luby, .Randomize = true},
+  };
+  solver_latin_t algoL;
+  for (const grid_t& values : grids)
+  {
+    CHECK(setup(algoL, values) && algoL.solve());
+    const std::string expected = format([&algoL](const tda::Coord& c) { return algoL.value(c); });
+    CHECK(valid(values, expected));
+    for (const options_t& options : configurations)
+    {
+      solver_dense_t algoC;
+      build(algoC, values, options);
+      const std::string solution = solveGeneric(algoC);
+      CHECK(valid(values, solution));
+    }
+    solver_static_t algoS;
+    build(algoS, values, {.Mode = Trail});
+    CHECK(solveGeneric(algoS) == expected);
+  }
+}
+
+// Les retours arrière par copie et par journal parcourent le même arbre, quelle que soit l'heuristique
+void testSameTree(const std::vector<grid_t>& grids)
+{
+  for (const solver::Heuristic order : {solver::Heuristic::Comparator, solver::Heuristic::Dom, solver::Heuristic::DomWdeg,
+                                        solver::Heuristic::Impact})
+  {
+    for (const grid_t& values : grids)
+    {
+      solver_dense_t algoCopy;
+      solver_dense_t algoTrail;
+      build(algoCopy, values, {.Order = order});
+      build(algoTrail, values, {.Mode = solver::BacktrackMode::Trail, .Order = order});
+      CHECK(solveGeneric(algoCopy) == solveGeneric(algoTrail));
+      CHECK(algoCopy.choicePoints() == algoTrail.choicePoints());
+    }
+  }
+}
+
+// Même nombre de solutions pour le moteur spécialisé, l'énumération et le dénombrement exact du solveur générique
+void testCounts(const grid_t& grid)
+{
+  // grille privée de ses derniers chiffres donnés jusqu'à avoir plusieurs solutions
+  grid_t values = grid;
+  solver_latin_t algoL;
+  for (size_t k = (SquareSize * SquareSize); (k > 0U) && setup(algoL, values) && (algoL.countSolutions(2U) < 2U); --k)
+  {
+    values[(k - 1U) / SquareSize][(k - 1U) % SquareSize] = 0U;
+  }
+  CHECK(setup(algoL, values));
+  const size_t expected = algoL.countSolutions();
+  CHECK(expected > 1U);
+  for (const solver::BacktrackMode mode : {solver::BacktrackMode::Copy, solver::BacktrackMode::Trail})
+  {
+    solver_static_t algoC;
+    build(algoC, values, {.Mode = mode});
+    CHECK(algoC.countSolutions() == expected);
+    build(algoC, values, {.Mode = mode});
+    CHECK(algoC.countExact() == expected);
+    build(algoC, values, {.Mode = mode});
+    CHECK(algoC.countExact(2U) == 2U);
+  }
+  solver_static_t algoD;
+  build(algoD, values, {.Mode = solver::BacktrackMode::Trail, .Decomposition = true});
+  CHECK(algoD.countSolutions() == expected);
+  // grille complète : une seule solution
+  build(algoD, grid, {});
+  CHECK(algoD.countExact() == 1U);
+}
+
+// Le moteur par bandes parcourt le même arbre que LatinSquare : même solution, mêmes points de choix,
+// même nombre de solutions, qu'il charge la grille en une fois (setup) ou chiffre par chiffre (assign)
+void testBands(const std::vector<grid_t>& grids)
+{
+  solver_latin_t algoL;
+  solver_bands_t algoB;
+  solver_bands_t algoA;
+  for (const grid_t& values : grids)
+  {
+    CHECK(setup(algoL, values) && algoL.solve());
+    CHECK(setup(algoB, values) && algoB.solve());
+    algoA.clear();
+    for (size_t i = 0U; i < SquareSize; ++i)
+    {
+      for (size_t j = 0U; j < SquareSize; ++j)
+      {
+        CHECK((values[i][j] == 0U) || algoA.assign({i, j}, values[i][j]));
+      }
+    }
+    CHECK(algoA.solve());
+    const std::string expected = format([&algoL](const tda::Coord& c) { return algoL.value(c); });
+    CHECK(format([&algoB](const tda::Coord& c) { return algoB.value(c); }) == expected);
+    CHECK(format([&algoA](const tda::Coord& c) { return algoA.value(c); }) == expected);
+    CHECK((algoB.choicePoints() == algoL.choicePoints()) && (algoA.choicePoints() == algoL.choicePoints()));
+  }
+  // grille privée de ses derniers chiffres donnés : plusieurs solutions, dénombrées comme LatinSquare
+  grid_t values = grids.front();
+  for (size_t k = (SquareSize * SquareSize); k > (SquareSize * SquareSize) - 30U; --k)
+  {
+    values[(k - 1U) / SquareSize][(k - 1U) % SquareSize] = 0U;
+  }
+  CHECK(setup(algoL, values) && setup(algoB, values));
+  const size_t expected = algoL.countSolutions();
+  CHECK((expected > 1U) && (algoB.countSolutions() == expected) && (algoB.choicePoints() == algoL.choicePoints()));
+  CHECK(algoB.countSolutions(2U) == 2U);
+  // chiffres donnés qui se contredisent, sur une ligne, dans un bloc ou dans une colonne d'une autre bande
+  for (const tda::Coord& coord : {tda::Coord{0U, 8U}, tda::Coord{2U, 2U}, tda::Coord{7U, 0U}})
+  {
+    values = {};
+    values[0U][0U] = 5U;
+    values[coord.X][coord.Y] = 5U;
+    CHECK(!setup(algoB, values) && !algoB.solve());
+    CHECK(format([&algoB](const tda::Coord& c) { return algoB.value(c); }) == std::string(SquareSize * SquareSize, '0'));
+    algoB.clear();
+    CHECK(algoB.assign({0U, 0U}, 5U) && !algoB.assign(coord, 5U));
+  }
+  values = {};
+  values[4U][4U] = 10U;
+  CHECK(!setup(algoB, values));
+}
+
+// Un solveur réutilisé d'une grille à l'autre (reset) donne la même solution en parcourant le même arbre qu'un solveur neuf,
+// la même grille résolue à nouveau (reload) donne la même solution
+template<class SolverT>
+void testReuse(const std::vector<grid_t>& grids, const options_t& options)
+{
+  SolverT algoR;
+  configure(algoR, options);
+  model(algoR, options);
+  CHECK(!algoR.reloadable());
+  algoR.setReloadable(true);
+  for (const grid_t& values : grids)
+  {
+    SolverT algoN;
+    build(algoN, values, options);
+    const std::string expected = solveGeneric(algoN);
+    CHECK(valid(values, expected));
+    algoR.reset();
+    load(algoR, values);
+    const size_t before = algoR.choicePoints();
+    CHECK(solveGeneric(algoR) == expected);
+    CHECK(algoR.choicePoints() - before == algoN.choicePoints());
+    CHECK(algoR.solutions().size() == 1U);
+    algoR.reload();
+    CHECK(solveGeneric(algoR) == expected);
+    CHECK(algoR.solutions().size() == 1U);
+  }
+}
+
+// Budgets de la recherche : une recherche interrompue se termine avec le statut Unknown,
+// une recherche qui tient dans son budget conclut normalement
+void testBudgets(const grid_t& grid)
+{
+  constexpr size_t Limit = 20U;
+  const grid_t empty{};
+  for (const size_t threads : {1U, 4U})
+  {
+    solver_dense_t algoC;
+    build(algoC, empty, {.Mode = solver::BacktrackMode::Trail, .Threads = threads});
+    algoC.setReloadable(true);
+    algoC.setNodeLimit(Limit);
+    size_t before = algoC.choicePoints();
+    algoC.solveAll();
+    CHECK(algoC.status() == solver::SearchStatus::Unknown);
+    CHECK(algoC.choicePoints() - before <= Limit);
+    algoC.reload();
+    algoC.countExact();
+    CHECK(algoC.status() == solver::SearchStatus::Unknown);
+    algoC.setNodeLimit(0U);
+    algoC.setTimeLimit(std::chrono::milliseconds(1));
+    algoC.reload();
+    algoC.solveAll();
+    CHECK(algoC.status() == solver::SearchStatus::Unknown);
+  }
+  solver_dense_t algoC;
+  build(algoC, grid, {.Mode = solver::BacktrackMode::Trail});
+  algoC.setNodeLimit(1000000U);
+  algoC.setTimeLimit(std::chrono::milliseconds(60000));
+  CHECK(algoC.solve() && (algoC.status() == solver::SearchStatus::Satisfiable));
+  // deux 8 sur la première ligne
+  grid_t contradiction = grid;
+  contradiction[0U][1U] = 8U;
+  contradiction[0U][0U] = 8U;
+  build(algoC, contradiction, {.Mode = solver::BacktrackMode::Trail});
+  algoC.setNodeLimit(Limit);
+  CHECK(!algoC.solve() && (algoC.status() == solver::SearchStatus::Unsatisfiable));
+}
+
+// Statistiques : compteurs globaux égaux aux sommes des compteurs par contrainte, remis à zéro par resetStatistics()
+void testStatistics(const std::vector<grid_t>& grids)
+{
+  for (const size_t threads : {1U, 4U})
+  {
+    size_t failures = 0U;
+    for (const grid_t& values : grids)
+    {
+      solver_dense_t algoC;
+      build(algoC, values, {.Mode = solver::BacktrackMode::Trail, .Threads = threads});
+      CHECK(valid(values, solveGeneric(algoC)));
+      const solver::SolverStatistics stats = algoC.statistics();
+      CHECK((stats.Nodes == algoC.choicePoints()) && (stats.Propagations == algoC.propagations()));
+      CHECK((stats.Solutions >= 1U) && !stats.Constraints.empty());
+      size_t calls = 0U;
+      size_t constraintFailures = 0U;
+      size_t exclusions = 0U;
+      for (const solver::ConstraintStatistics& constraint : stats.Constraints)
+      {
+        calls += constraint.Calls;
+        constraintFailures += constraint.Failures;
+        exclusions += constraint.Exclusions;
+      }
+      CHECK(calls == stats.Propagations);
+      CHECK(constraintFailures == stats.Failures);
+      CHECK((exclusions > 0U) && (exclusions <= stats.Exclusions));
+      failures += stats.Failures;
+      algoC.resetStatistics();
+      const solver::SolverStatistics cleared = algoC.statistics();
+      CHECK((cleared.Nodes == 0U) && (cleared.Propagations == 0U) && (cleared.Failures == 0U) && (cleared.Exclusions == 0U));
+      CHECK(std::all_of(cleared.Constraints.begin(), cleared.Constraints.end(),
+                        [](const solver::ConstraintStatistics& constraint) { return constraint.Calls == 0U; }));
+    }
+    // les grilles difficiles demandent des retours arrière
+    CHECK(failures > 0U);
+  }
+}
+
+// Grilles mal formées : longueur, caractère ou valeur hors de la grille
+void testMalformed()
+{
+  const std::string grid = "800000040300800560002003000500000004007060950000900002200600830000000009010070000";
+  CHECK(parse(grid).has_value());
+  CHECK(!parse(grid.substr(1U)).has_value());
+  CHECK(!parse(grid + "0").has_value());
+  std::string line = grid;
+  line[0U] = '#';
+  CHECK(!parse(line).has_value());
+  line[0U] = 'A';
+  CHECK(!parse(line).has_value());
+  CHECK(!parse<4U>("1234341221434325").has_value());
+  CHECK(parse<4U>("1234341221434321").has_value());
+  CHECK(!squareSize(80U).has_value());
+  CHECK(squareSize(256U) == 16U);
+  // deux chiffres donnés qui se contredisent
+  std::optional<grid_t> values = parse(grid);
+  (*values)[0U][1U] = 8U;
+  solver_latin_t algoL;
+  CHECK(!setup(algoL, *values));
+  solver_bands_t algoB;
+  CHECK(!setup(algoB, *values));
+}
+
+// Enregistrement du corpus binaire : une case de 4 bits au-delà de 9 est refusée au lieu de sortir du domaine
+void testRecord(const grid_t& grid)
+{
+  solver::GridRecord record(solver::CorpusKind::Sudoku, SquareSize);
+  for (size_t i = 0U; i < SquareSize; ++i)
+  {
+    for (size_t j = 0U; j < SquareSize; ++j)
+    {
+      record.setValue({i, j}, grid[i][j]);
+    }
+  }
+  solver_static_t algoC;
+  model(algoC);
+  solver_latin_t algoL;
+  CHECK(readable<SquareSize>(record.view()));
+  CHECK(load(algoC, record.view()) && algoC.solve());
+  CHECK(setup(algoL, record.view()) && algoL.solve());
+  solver_bands_t algoB;
+  CHECK(setup(algoB, record.view()) && algoB.solve());
+  for (const size_t corrupt : {10U, 15U})
+  {
+    record.setValue({4U, 4U}, corrupt);
+    CHECK(!readable<SquareSize>(record.view()));
+    algoC.reset();
+    CHECK(!load(algoC, record.view()));
+    CHECK(!setup(algoL, record.view()));
+    CHECK(!setup(algoB, record.view()));
+  }
+  CHECK(!readable<SquareSize>(solver::GridRecord(solver::CorpusKind::Sudoku, 4U).view()));
+}
+
+// Affectations de valeurs toutes différentes prises dans les intervalles ranges : plus petite et plus grande valeur
+// de chaque variable parmi ces affectations, first > second pour toutes si aucune n'existe
+void enumerate(const std::vector<std::pair<size_t, size_t>>& ranges, std::vector<size_t>& values,
+               std::vector<std::pair<size_t, size_t>>& reached)
+{
+  const size_t k = values.size();
+  if (k == ranges.size())
+  {
+    for (size_t i = 0U; i < k; ++i)
+    {
+      reached[i] = {std::min(reached[i].first, values[i]), std::max(reached[i].second, values[i])};
+    }
+    return;
+  }
+  for (size_t value = ranges[k].first; value <= ranges[k].second; ++value)
+  {
+    if (std::find(values.begin(), values.end(), value) == values.end())
+    {
+      values.push_back(value);
+      enumerate(ranges, values, reached);
+      values.pop_back();
+    }
+  }
+}
+
+// Filtrage AllDifferent par bornes comparé à l'énumération des affectations : en un appel, chaque variable garde
+// exactement les bornes atteintes par une affectation, et le filtrage échoue s'il n'y en a aucune
+void testAllDifferentBounds()
+{
+  std::mt19937 random(2026U);
+  std::uniform_int_distribution<size_t> pick(1U, SquareSize);
+  std::uniform_int_distribution<size_t> count(2U, 6U);
+  const auto domain = tda::ValueEnum<SquareSize>;
+  for (size_t trial = 0U; trial < 1000U; ++trial)
+  {
+    const size_t n = count(random);
+    std::vector<tda::Coord> indices;
+    std::vector<std::pair<size_t, size_t>> ranges;
+    solver_dense_t algoC;
+    for (size_t k = 0U; k < n; ++k)
+    {
+      const size_t a = pick(random);
+      const size_t b = pick(random);
+      ranges.emplace_back(std::min(a, b), std::max(a, b));
+      indices.push_back({0U, k});
+      algoC.addVariable(domain.begin() + (ranges.back().first - 1U), domain.begin() + ranges.back().second, {0U, k});
+    }
+    std::vector<size_t> values;
+    std::vector<std::pair<size_t, size_t>> reached(n, {SquareSize + 1U, 0U});
+    enumerate(ranges, values, reached);
+    solver::AllDifferent<solver_dense_t> constraint(indices, solver::Consistency::Bounds);
+    const bool feasible = (reached.front().first <= reached.front().second);
+    CHECK(constraint(algoC, indices.front(), 1U) == feasible);
+    for (size_t k = 0U; (k < n) && feasible; ++k)
+    {
+      const auto& var = algoC.get(indices[k]);
+      CHECK((var.domain().min() == reached[k].first) && (var.domain().max() == reached[k].second));
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const std::string corpus = (argc > 1) ? argv[1] : TESTS_CORPUS_DIR;
+  std::vector<grid_t> grids;
+  for (const char* level : {"easy", "hard", "17"})
+  {
+    const std::vector<grid_t> levelGrids = readCorpus(corpus + "/sudoku_" + level + ".txt", GridsPerLevel);
+    grids.insert(grids.end(), levelGrids.begin(), levelGrids.end());
+  }
+  testSolutions(grids);
+  testSameTree(grids);
+  testCounts(grids.front());
+  testBands(grids);
+  testReuse<solver_static_t>(grids, {.Mode = solver::BacktrackMode::Trail});
+  testReuse<solver_dense_t>(grids, {.Mode = solver::BacktrackMode::Trail, .Order = solver::Heuristic::DomWdeg});
+  testReuse<solver_constraint_t>(grids, {.AllDifferent = solver::Consistency::Domain});
+  testBudgets(grids.front());
+  testStatistics(grids);
+  testMalformed();
+  testRecord(grids.front());
+  testAllDifferentBounds();
+  return check::result();
+}